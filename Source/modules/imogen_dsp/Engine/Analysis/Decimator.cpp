@@ -0,0 +1,88 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void Decimator<SampleType>::prepare (double samplerate, int blocksize)
+{
+	factor			 = std::max (1, static_cast<int> (samplerate / targetSamplerate));
+	outputSamplerate = samplerate / factor;
+	maxBlocksize	 = blocksize;
+
+	numTaps = factor == 1 ? 1 : factor * tapsPerPhase + 1;
+
+	coefficients.assign (static_cast<size_t> (numTaps), SampleType (1));
+
+	if (factor > 1)
+	{
+		// Blackman-windowed sinc, cut off a little below the decimated Nyquist
+		const auto cutoff = 0.9 / (2. * factor);
+		const auto centre = (numTaps - 1) * 0.5;
+
+		auto sum = 0.;
+
+		for (auto i = 0; i < numTaps; ++i)
+		{
+			const auto x	  = i - centre;
+			const auto sinc	  = x == 0. ? 2. * cutoff : std::sin (juce::MathConstants<double>::twoPi * cutoff * x) / (juce::MathConstants<double>::pi * x);
+			const auto window = 0.42 - 0.5 * std::cos (juce::MathConstants<double>::twoPi * i / (numTaps - 1))
+							  + 0.08 * std::cos (2. * juce::MathConstants<double>::twoPi * i / (numTaps - 1));
+
+			coefficients[static_cast<size_t> (i)] = static_cast<SampleType> (sinc * window);
+			sum += sinc * window;
+		}
+
+		for (auto& coefficient : coefficients)
+			coefficient = static_cast<SampleType> (coefficient / sum);
+	}
+
+	buffer.assign (static_cast<size_t> (numTaps - 1 + blocksize), SampleType (0));
+	output.assign (static_cast<size_t> (blocksize / factor + 1), SampleType (0));
+
+	reset();
+}
+
+template <typename SampleType>
+void Decimator<SampleType>::reset()
+{
+	std::fill (buffer.begin(), buffer.end(), SampleType (0));
+	phase = 0;
+}
+
+template <typename SampleType>
+int Decimator<SampleType>::process (const SampleType* input, int numSamples) noexcept
+{
+	jassert (numSamples <= maxBlocksize);
+
+	const auto history = numTaps - 1;
+
+	std::copy (input, input + numSamples, buffer.begin() + history);
+
+	auto numOut = 0;
+
+	// phase is the offset of the next kept sample within this block
+	for (auto i = phase; i < numSamples; i += factor)
+	{
+		const auto* window = buffer.data() + i;
+
+		auto sum = SampleType (0);
+
+		for (auto tap = 0; tap < numTaps; ++tap)
+			sum += window[tap] * coefficients[static_cast<size_t> (numTaps - 1 - tap)];
+
+		output[static_cast<size_t> (numOut++)] = sum;
+	}
+
+	phase = (phase - numSamples) % factor;
+
+	if (phase < 0)
+		phase += factor;
+
+	std::copy (buffer.begin() + numSamples, buffer.begin() + numSamples + history, buffer.begin());
+
+	return numOut;
+}
+
+template class Decimator<float>;
+template class Decimator<double>;
+
+}  // namespace Imogen
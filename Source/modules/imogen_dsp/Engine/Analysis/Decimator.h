@@ -0,0 +1,44 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	Decimates the input by a whole factor so that the pitch detector runs at roughly the same rate at any host samplerate.
+	The anti-alias FIR is only evaluated at the output samples that are kept.
+	Only the FFT pitch detector reads the decimated signal; the psola analyzer, which places the grains, still runs at the full rate.
+*/
+template <typename SampleType>
+class Decimator
+{
+public:
+
+	void prepare (double samplerate, int blocksize);
+
+	void reset();
+
+	/* Returns the number of decimated samples written to getOutput(). */
+	int process (const SampleType* input, int numSamples) noexcept;
+
+	const SampleType* getOutput() const noexcept { return output.data(); }
+
+	int getFactor() const noexcept { return factor; }
+
+	double getOutputSamplerate() const noexcept { return outputSamplerate; }
+
+	static constexpr double targetSamplerate = 24000.;
+
+private:
+
+	static constexpr int tapsPerPhase = 8;
+
+	std::vector<SampleType> coefficients, buffer, output;
+
+	double outputSamplerate { targetSamplerate };
+
+	int factor { 1 };
+	int numTaps { 1 };
+	int phase { 0 };
+	int maxBlocksize { 0 };
+};
+
+}  // namespace Imogen
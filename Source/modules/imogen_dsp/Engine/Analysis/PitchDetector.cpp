@@ -0,0 +1,177 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void PitchDetector<SampleType>::prepare (double samplerateToUse, int)
+{
+	samplerate = samplerateToUse;
+
+	minPeriod = juce::roundToInt (samplerate / maxFrequency);
+	maxPeriod = juce::roundToInt (samplerate / minFrequency);
+
+	// each frame integrates over one longest period, at lags up to one longest period
+	frameLength = maxPeriod * 2;
+
+	// big enough that the circular correlation can't wrap into the lags we read back
+	const auto order = juce::roundToInt (std::ceil (std::log2 (frameLength + maxPeriod)));
+
+	fft		= std::make_unique<juce::dsp::FFT> (order);
+	fftSize = fft->getSize();
+
+	history.assign (static_cast<size_t> (frameLength), 0.f);
+	frameSpectrum.assign (static_cast<size_t> (fftSize * 2), 0.f);
+	windowSpectrum.assign (static_cast<size_t> (fftSize * 2), 0.f);
+	energies.assign (static_cast<size_t> (maxPeriod), 0.f);
+	difference.assign (static_cast<size_t> (maxPeriod), 0.f);
+
+	reset();
+}
+
+template <typename SampleType>
+void PitchDetector<SampleType>::reset()
+{
+	std::fill (history.begin(), history.end(), 0.f);
+
+	numStored	 = 0;
+	frequency	 = 0.f;
+	aperiodicity = 1.f;
+}
+
+template <typename SampleType>
+void PitchDetector<SampleType>::process (const SampleType* input, int numSamples)
+{
+	jassert (fft != nullptr);
+
+	const auto numNew = std::min (numSamples, frameLength);
+	const auto numOld = frameLength - numNew;
+
+	input += numSamples - numNew;
+
+	if (numOld > 0)
+		std::memmove (history.data(), history.data() + numNew, sizeof (float) * static_cast<size_t> (numOld));
+
+	for (auto i = 0; i < numNew; ++i)
+		history[static_cast<size_t> (numOld + i)] = static_cast<float> (input[i]);
+
+	numStored = std::min (numStored + numSamples, frameLength);
+
+	if (numStored < frameLength)
+		return;
+
+	frequency = detect();
+}
+
+template <typename SampleType>
+float PitchDetector<SampleType>::detect() noexcept
+{
+	computeDifference();
+
+	// cumulative mean normalization, done in place
+	difference[0] = 1.f;
+
+	auto runningSum = 0.f;
+
+	for (auto tau = 1; tau < maxPeriod; ++tau)
+	{
+		runningSum += difference[static_cast<size_t> (tau)];
+
+		if (runningSum > 0.f)
+			difference[static_cast<size_t> (tau)] *= static_cast<float> (tau) / runningSum;
+		else
+			difference[static_cast<size_t> (tau)] = 1.f;
+	}
+
+	for (auto tau = minPeriod; tau < maxPeriod - 1; ++tau)
+	{
+		if (difference[static_cast<size_t> (tau)] >= threshold)
+			continue;
+
+		while (tau + 1 < maxPeriod - 1 && difference[static_cast<size_t> (tau + 1)] < difference[static_cast<size_t> (tau)])
+			++tau;
+
+		aperiodicity = difference[static_cast<size_t> (tau)];
+
+		return static_cast<float> (samplerate) / interpolatePeriod (tau);
+	}
+
+	aperiodicity = 1.f;
+	return 0.f;
+}
+
+/*
+	d(tau) = e(0) + e(tau) - 2 r(tau), where e(tau) is the energy of the window starting at tau
+	and r(tau) is the cross-correlation of the first window with the whole frame.
+*/
+template <typename SampleType>
+void PitchDetector<SampleType>::computeDifference() noexcept
+{
+	using FVO = juce::FloatVectorOperations;
+
+	std::fill (frameSpectrum.begin(), frameSpectrum.end(), 0.f);
+	std::fill (windowSpectrum.begin(), windowSpectrum.end(), 0.f);
+
+	FVO::copy (frameSpectrum.data(), history.data(), frameLength);
+	FVO::copy (windowSpectrum.data(), history.data(), maxPeriod);
+
+	fft->performRealOnlyForwardTransform (frameSpectrum.data());
+	fft->performRealOnlyForwardTransform (windowSpectrum.data());
+
+	// frame * conj (window)
+	for (auto bin = 0; bin < fftSize; ++bin)
+	{
+		const auto re = static_cast<size_t> (bin * 2);
+		const auto im = re + 1;
+
+		const auto a = frameSpectrum[re], b = frameSpectrum[im];
+		const auto c = windowSpectrum[re], d = windowSpectrum[im];
+
+		frameSpectrum[re] = a * c + b * d;
+		frameSpectrum[im] = b * c - a * d;
+	}
+
+	fft->performRealOnlyInverseTransform (frameSpectrum.data());
+
+	auto energy = 0.f;
+
+	for (auto i = 0; i < maxPeriod; ++i)
+		energy += history[static_cast<size_t> (i)] * history[static_cast<size_t> (i)];
+
+	const auto firstEnergy = energy;
+
+	for (auto tau = 0; tau < maxPeriod; ++tau)
+	{
+		energies[static_cast<size_t> (tau)] = energy;
+
+		const auto leaving	= history[static_cast<size_t> (tau)];
+		const auto entering = history[static_cast<size_t> (tau + maxPeriod)];
+
+		energy += entering * entering - leaving * leaving;
+	}
+
+	FVO::multiply (difference.data(), frameSpectrum.data(), -2.f, maxPeriod);
+	FVO::add (difference.data(), energies.data(), maxPeriod);
+	FVO::add (difference.data(), firstEnergy, maxPeriod);
+}
+
+template <typename SampleType>
+float PitchDetector<SampleType>::interpolatePeriod (int period) const noexcept
+{
+	if (period <= 0 || period >= maxPeriod - 1)
+		return static_cast<float> (period);
+
+	const auto prev = difference[static_cast<size_t> (period - 1)];
+	const auto curr = difference[static_cast<size_t> (period)];
+	const auto next = difference[static_cast<size_t> (period + 1)];
+
+	const auto denominator = prev - 2.f * curr + next;
+
+	if (std::abs (denominator) < 1.0e-9f)
+		return static_cast<float> (period);
+
+	return static_cast<float> (period) + 0.5f * (prev - next) / denominator;
+}
+
+template class PitchDetector<float>;
+template class PitchDetector<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+namespace Imogen
+{
+/*
+	A YIN pitch detector that gets its difference function from one FFT cross-correlation per block
+	instead of a direct O(n^2) sum. Works in single precision internally regardless of the engine's sample type.
+*/
+template <typename SampleType>
+class PitchDetector
+{
+public:
+
+	void prepare (double samplerate, int blocksize);
+
+	void reset();
+
+	void process (const SampleType* input, int numSamples);
+
+	/* Returns 0 if the last frame was unpitched. */
+	float getFrequency() const noexcept { return frequency; }
+
+	/* The normalized difference at the chosen period; lower is more periodic. */
+	float getAperiodicity() const noexcept { return aperiodicity; }
+
+	int getLatencySamples() const noexcept { return frameLength; }
+
+	static constexpr float minFrequency = 60.f;
+	static constexpr float maxFrequency = 1500.f;
+
+private:
+
+	[[nodiscard]] float detect() noexcept;
+
+	void computeDifference() noexcept;
+
+	[[nodiscard]] float interpolatePeriod (int period) const noexcept;
+
+	static constexpr float threshold = 0.15f;
+
+	std::unique_ptr<juce::dsp::FFT> fft;
+
+	std::vector<float> history, frameSpectrum, windowSpectrum, energies, difference;
+
+	double samplerate { 44100. };
+
+	int minPeriod { 0 }, maxPeriod { 0 }, frameLength { 0 }, fftSize { 0 };
+	int numStored { 0 };
+
+	float frequency { 0.f };
+	float aperiodicity { 1.f };
+};
+
+}  // namespace Imogen
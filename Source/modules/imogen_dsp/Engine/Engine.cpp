@@ -9,8 +9,12 @@ Engine<SampleType>::Engine (State& stateToUse)
 template <typename SampleType>
 void Engine<SampleType>::renderChunk (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool)
 {
-	output.clear();
-	updateStereoWidth (parameters.stereoWidth->get());
+	const RealtimeScope realtimeScope;
+
+	const auto startTicks = juce::Time::getHighResolutionTicks();
+
+	snapshot.capture (parameters);
+	updateStereoWidth();
 
 	const bool leadIsBypassed		= parameters.leadBypass->get();
 	const bool harmoniesAreBypassed = parameters.harmonyBypass->get();
@@ -20,45 +24,347 @@ void Engine<SampleType>::renderChunk (const AudioBuffer& input, AudioBuffer& out
 	if (leadIsBypassed && harmoniesAreBypassed)
 	{
 		harmonizer.bypassedBlock (numSamples, midiMessages);
+		stagedNumSamples = 0;
+		output.clear();
+		clearMeters();
 		return;
 	}
 
+	if (pipeline != nullptr)
+		pipeline->start();
+
 	preHarmonyEffects.process (input);
 
+	if (updateIdleState (midiMessages, numSamples))
+	{
+		harmonizer.bypassedBlock (numSamples, midiMessages);
+		renderIdleChunk (input, output, numSamples);
+		updateLoadShedding (startTicks, numSamples);
+		return;
+	}
+
+	tailHasDecayed = false;
+
 	analyzer.analyzeInput (preHarmonyEffects.getProcessedInputSignal(), numSamples);
 
-	harmonizer.process (numSamples, midiMessages, harmoniesAreBypassed);
+	// the decimator only exists to feed this detector, so neither runs unless it's been chosen for the readout
+	const bool useFftDetector = state.internals.fftPitchDetection->get();
+
+	if (useFftDetector)
+	{
+		const auto numDecimated = detectorDecimator.process (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+		pitchDetector.process (detectorDecimator.getOutput(), numDecimated);
+	}
+
+	harmonizer.setLoadSheddingLevel (loadGovernor.getLevel());
+	// without the pipeline, the voices are summed straight into the host's output and every post effect runs there in place
+	const auto renderInPlace = pipeline == nullptr && output.getNumChannels() == 2;
+
+	harmonizer.process (numSamples, midiMessages, harmoniesAreBypassed, preHarmonyEffects.getInputLevel(),
+						renderInPlace ? &output : nullptr);
 
 	leadProcessor.process (leadIsBypassed, numSamples);
 
-	postHarmonyEffects.process (harmonizer.getHarmonySignal(), leadProcessor.getProcessedSignal(), output);
+	if (useFftDetector)
+		updatePitchReadout();
+	else if (leadIsBypassed)
+		clearPitchReadout();  // the pitch corrector drives the readout otherwise, and doesn't run while the lead is bypassed
+
+	finishChunk (harmonizer.getHarmonySignal(), leadProcessor.getProcessedSignal(), output, numSamples);
+
+	updateMeters (input, output, numSamples);
+
+	updateLoadShedding (startTicks, numSamples);
 }
 
 template <typename SampleType>
-void Engine<SampleType>::updateStereoWidth (int width)
+void Engine<SampleType>::finishChunk (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output, int numSamples)
 {
-	harmonizer.panner.updateStereoWidth (width);
-	postHarmonyEffects.updateStereoWidth (width);
+	if (pipeline == nullptr)
+	{
+		processPostEffects (harmonySignal, drySignal, output);
+		return;
+	}
+
+	pipeline->waitForCompletion();
+
+	const auto numReady = std::min (stagedNumSamples, numSamples);
+
+	for (auto chan = 0; chan < output.getNumChannels(); ++chan)
+		output.copyFrom (chan, 0, stagedOutput, chan % 2, 0, numReady);
+
+	if (numReady < numSamples)
+		output.clear (numReady, numSamples - numReady);
+
+	stageForPostEffects (harmonySignal, drySignal, numSamples);
 }
 
 template <typename SampleType>
-void Engine<SampleType>::onPrepare (int blocksize, double samplerate)
+bool Engine<SampleType>::updateIdleState (const MidiBuffer& midiMessages, int numSamples)
 {
-	if (! harmonizer.isInitialized())
-		harmonizer.initialize (16, samplerate, blocksize);
+	const auto range = juce::FloatVectorOperations::findMinAndMax (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+	const auto peak	 = std::max (-range.getStart(), range.getEnd());
 
-	analyzer.prepare (samplerate, blocksize);
+	if (peak < silenceThreshold && midiMessages.isEmpty() && ! harmonizer.isSounding())
+		silentChunks = std::min (silentChunks + 1, chunksBeforeIdle);
+	else
+		silentChunks = 0;
+
+	return silentChunks == chunksBeforeIdle;
+}
+
+template <typename SampleType>
+void Engine<SampleType>::renderIdleChunk (const AudioBuffer& input, AudioBuffer& output, int numSamples)
+{
+	if (tailHasDecayed)
+	{
+		if (pipeline != nullptr)
+		{
+			pipeline->waitForCompletion();
+			stagedNumSamples = 0;
+		}
+
+		output.clear();
+		return;
+	}
+
+	auto harmony = sliceOf (idleHarmony, 0, numSamples);
+	auto lead	 = sliceOf (idleLead, 0, numSamples);
+
+	harmony.clear();
+	lead.clear();
+
+	finishChunk (harmony, lead, output, numSamples);
+
+	// the delay and reverb know from their own state when their tails have gone; the other stages' state lasts
+	// a few milliseconds at most, and the output catches whatever of it is left
+	tailHasDecayed = postHarmonyEffects.tailsAreAsleep() && output.getMagnitude (0, numSamples) < tailThreshold;
+
+	if (! tailHasDecayed)
+	{
+		updateMeters (input, output, numSamples);
+		return;
+	}
+
+	clearMeters();
+	clearPitchReadout();
+}
+
+template <typename SampleType>
+void Engine<SampleType>::updateLoadShedding (juce::int64 startTicks, int numSamples)
+{
+	const auto elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTicks);
+
+	loadGovernor.update (elapsed, static_cast<double> (numSamples) / samplerate);
+
+	auto& internals = state.internals;
+
+	internals.loadSheddingLevel->set (loadGovernor.getLevel());
+	internals.loadSheddingEvents->set (loadGovernor.getNumDegradations());
+}
+
+template <typename SampleType>
+void Engine<SampleType>::clearPitchReadout()
+{
+	state.internals.currentInputNote->set (-1);
+	state.internals.currentCentsSharp->set (0);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::updatePitchReadout()
+{
+	auto& internals = state.internals;
+
+	const auto frequency = pitchDetector.getFrequency();
+
+	if (frequency <= 0.f)
+	{
+		clearPitchReadout();
+		return;
+	}
+
+	const auto midiPitch = 69.f + 12.f * std::log2 (frequency / 440.f);
+	const auto note		 = juce::roundToInt (midiPitch);
+
+	internals.currentInputNote->set (note);
+	internals.currentCentsSharp->set (juce::roundToInt ((midiPitch - static_cast<float> (note)) * 100.f));
+}
+
+template <typename SampleType>
+void Engine<SampleType>::updateMeters (const AudioBuffer& input, const AudioBuffer& output, int numSamples)
+{
+	// this runs after finishChunk(), so the pipeline thread is done writing its gain reductions into the readings
+	auto& meters = state.meters;
+
+	const auto notifyHost = state.internals.hostMetering->get();
+
+	// the true peak's interpolator isn't free, so nothing is measured while no editor is open and the host isn't being sent meters
+	if (! notifyHost && ! meters.snapshot.hasReaders())
+	{
+		isMetering = false;
+		return;
+	}
 
-	if (const auto latency = analyzer.getLatencySamples() > 0)
+	// what was held from before metering stopped is stale
+	if (! isMetering)
 	{
-		dsp::LatencyEngine<SampleType>::changeLatency (latency);
+		metering.reset();
+		isMetering = true;
+	}
+
+	// the input meter shows what arrives from the host, on the channels the input mode listens to, before any gain, filter or gate
+	const auto mode		   = parameters.inputMode->get();
+	const auto lastChannel = input.getNumChannels() - 1;
+
+	const auto* inputLeft  = input.getReadPointer (mode == 2 ? std::min (1, lastChannel) : 0);
+	const auto* inputRight = input.getReadPointer (mode == 1 ? 0 : std::min (1, lastChannel));
+
+	metering.process (inputLeft, inputRight, output, numSamples, meters.readings);
+
+	meters.publish (notifyHost);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::clearMeters()
+{
+	auto& meters = state.meters;
+
+	metering.reset();
+	meters.readings = {};
+
+	meters.publish (state.internals.hostMetering->get());
+}
+
+template <typename SampleType>
+void Engine<SampleType>::updateStereoWidth()
+{
+	if (snapshot.consume (ParameterSnapshot::Group::pannerWidth))
+		harmonizer.panner.updateStereoWidth (snapshot.stereoWidth);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::processPostEffects (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output)
+{
+	// the reverb's width is only touched by whichever thread runs the post effects
+	if (snapshot.consume (ParameterSnapshot::Group::reverbWidth))
+		postHarmonyEffects.updateStereoWidth (snapshot.stereoWidth);
+	postHarmonyEffects.process (harmonySignal, drySignal, output);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::stageForPostEffects (const AudioBuffer& harmonySignal, const AudioBuffer& drySignal, int numSamples)
+{
+	for (auto chan = 0; chan < 2; ++chan)
+	{
+		stagedHarmony.copyFrom (chan, 0, harmonySignal, chan, 0, numSamples);
+		stagedLead.copyFrom (chan, 0, drySignal, chan, 0, numSamples);
+	}
+
+	stagedNumSamples = numSamples;
+}
+
+template <typename SampleType>
+void Engine<SampleType>::runPipelineStage()
+{
+	if (stagedNumSamples == 0)
+		return;
+
+	harmonyAlias.setDataToReferTo (stagedHarmony.getArrayOfWritePointers(), 2, stagedNumSamples);
+	leadAlias.setDataToReferTo (stagedLead.getArrayOfWritePointers(), 2, stagedNumSamples);
+	outputAlias.setDataToReferTo (stagedOutput.getArrayOfWritePointers(), 2, stagedNumSamples);
+
+	processPostEffects (harmonyAlias, leadAlias, outputAlias);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::preparePipeline (int blocksize)
+{
+	if (! state.internals.pipelinedRendering->get())
+	{
+		pipeline.reset();
+		pipelineLatency = 0;
 		return;
 	}
 
-	harmonizer.prepare (samplerate, blocksize);
-	leadProcessor.prepare (samplerate, blocksize);
-	preHarmonyEffects.prepare (samplerate, blocksize);
-	postHarmonyEffects.prepare (samplerate, blocksize);
+	arena.claim (stagedHarmony, 2, blocksize);
+	arena.claim (stagedLead, 2, blocksize);
+	arena.claim (stagedOutput, 2, blocksize);
+
+	stagedNumSamples = 0;
+	pipelineLatency	 = blocksize;
+
+	if (pipeline == nullptr)
+		pipeline = std::make_unique<PipelineWorker> (*this);
+}
+
+template <typename SampleType>
+int Engine<SampleType>::reportLatency() const noexcept
+{
+	return dsp::LatencyEngine<SampleType>::reportLatency() + pipelineLatency;
+}
+
+template <typename SampleType>
+void Engine<SampleType>::onPrepare (int blocksize, double samplerateToUse)
+{
+	samplerate = samplerateToUse;
+	loadGovernor.reset();
+
+	analyzer.setMinInputFreq (getMinInputFrequency());
+	analyzer.prepare (samplerate, blocksize);
+
+	// chunks are exactly as long as the analyzer's latency, so every stage is prepared for that size
+	const auto latency	 = analyzer.getLatencySamples();
+	const auto chunkSize = latency > 0 ? latency : blocksize;
+
+	dsp::LatencyEngine<SampleType>::changeLatency (chunkSize);
+
+	if (chunkSize != blocksize)
+		analyzer.prepare (samplerate, chunkSize);
+
+	// every stage's buffers are claimed from the arena as they're prepared below
+	arena.prepare (numArenaChannels, chunkSize, state.internals.lockAudioMemory->get());
+
+	const auto numVoices = state.internals.voiceCapacity->get();
+
+	// after the first prepare, the harmonizer hands changes of capacity to the audio thread itself
+	if (! harmonizer.isInitialized())
+		harmonizer.initialize (std::min (numVoices, Harmonizer<SampleType>::maxVoices), samplerate, chunkSize);
+
+	detectorDecimator.prepare (samplerate, chunkSize);
+	pitchDetector.prepare (detectorDecimator.getOutputSamplerate(), chunkSize / detectorDecimator.getFactor() + 1);
+
+	harmonizer.prepare (samplerate, chunkSize);
+	leadProcessor.prepare (samplerate, chunkSize);
+	preHarmonyEffects.prepare (samplerate, chunkSize);
+	postHarmonyEffects.prepare (samplerate, chunkSize);
+
+	preparePipeline (chunkSize);
+
+	arena.claim (idleHarmony, 2, chunkSize);
+	arena.claim (idleLead, 2, chunkSize);
+
+	// only what the engine lays out itself: the voices' own buffers, the library's effects, the pitch detector's FFTs
+	// and the reverbs' and convolution's lines all allocate separately and aren't counted here
+	const auto footprint = arena.getSizeInBytes() + harmonizer.getVoiceBankSizeInBytes();
+	state.internals.arenaFootprintKb->set (static_cast<int> (footprint / 1024));
+
+	silentChunks   = 0;
+	tailHasDecayed = false;
+
+	metering.prepare (samplerate);
+
+	// everything is pushed into the freshly prepared DSP objects on the first chunk
+	snapshot.markAllDirty();
+}
+
+template <typename SampleType>
+int Engine<SampleType>::getMinInputFrequency() const
+{
+	// live mode trades the lowest bass notes for a shorter detection window
+	if (state.internals.latencyMode->get() == 1)
+		return 100;
+
+	return 60;
 }
 
 
@@ -2,14 +2,22 @@
 
 #include <imogen_state/imogen_state.h>
 
+#include "Analysis/Decimator.h"
+#include "Analysis/PitchDetector.h"
 #include "Lead/LeadProcessor.h"
 #include "effects/PostHarmonyEffects.h"
 #include "effects/PreHarmonyEffects.h"
+#include "LoadGovernor.h"
+#include "Metering.h"
+#include "PipelineWorker.h"
+#include "ParameterSnapshot.h"
+#include "Utils/RealtimeSentinel.h"
 
 namespace Imogen
 {
 template <typename SampleType>
 class Engine : public dsp::LatencyEngine<SampleType>
+	, private PipelineWorker::Client
 {
 public:
 
@@ -17,26 +25,102 @@ public:
 
 	Engine (State& stateToUse);
 
+	int reportLatency() const noexcept final;
+
 private:
 
 	void renderChunk (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed) final;
 
 	void onPrepare (int blocksize, double samplerate) final;
 
-	void updateStereoWidth (int width);
+	int getMinInputFrequency() const;
+
+	void updateStereoWidth();
+
+	void processPostEffects (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output);
+
+	void preparePipeline (int blocksize);
+
+	void runPipelineStage() final;
+
+	void stageForPostEffects (const AudioBuffer& harmonySignal, const AudioBuffer& drySignal, int numSamples);
+
+	void finishChunk (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output, int numSamples);
+
+	[[nodiscard]] bool updateIdleState (const MidiBuffer& midiMessages, int numSamples);
+
+	void renderIdleChunk (const AudioBuffer& input, AudioBuffer& output, int numSamples);
+
+	void updateLoadShedding (juce::int64 startTicks, int numSamples);
+
+	void updatePitchReadout();
+	void clearPitchReadout();
+
+	void updateMeters (const AudioBuffer& input, const AudioBuffer& output, int numSamples);
+
+	void clearMeters();
 
 	State&		state;
 	Parameters& parameters { state.parameters };
 
+	ParameterSnapshot snapshot;
+
+	AudioArena<SampleType> arena;
+
 	dsp::psola::Analyzer<SampleType> analyzer;
 
-	PreHarmonyEffects<SampleType> preHarmonyEffects { state };
+	Decimator<SampleType>	  detectorDecimator;
+	PitchDetector<SampleType> pitchDetector;
+
+	PreHarmonyEffects<SampleType> preHarmonyEffects { state, arena };
+
+	Harmonizer<SampleType> harmonizer { state, analyzer, snapshot, arena };
+
+	LeadProcessor<SampleType> leadProcessor { harmonizer, state, arena };
+
+	PostHarmonyEffects<SampleType> postHarmonyEffects { state, snapshot, arena };
+
+	LoadGovernor loadGovernor;
+
+	Metering<SampleType> metering;
+	bool				 isMetering { false };
+
+	double samplerate { 44100. };
+
+	/*
+		In pipelined mode the post-harmony effects for the previous chunk run on their own thread
+		while this chunk is analysed and synthesised, at the cost of one extra chunk of latency.
+		Only the effects are moved off the audio thread. The analysis can't run a chunk ahead,
+		because every shifter reads the analyzer's state for the chunk it's rendering.
+	*/
+	std::unique_ptr<PipelineWorker> pipeline;
+
+	AudioBuffer stagedHarmony, stagedLead, stagedOutput;
+	AudioBuffer harmonyAlias, leadAlias, outputAlias;
+
+	int stagedNumSamples { 0 };
+	int pipelineLatency { 0 };
+
+	/*
+		Once the gated input has been silent and no voice has sounded for a few chunks, the analysis, voices and lead path are skipped.
+		The post chain keeps running on silence until its delay and reverb tails have died away, and then it's skipped too.
+	*/
+	static constexpr auto silenceThreshold = SampleType (1.0e-5);  // -100 dB
+	static constexpr auto tailThreshold	   = SampleType (1.0e-5);
+	static constexpr int  chunksBeforeIdle = 4;
 
-	Harmonizer<SampleType> harmonizer { state, analyzer };
+	AudioBuffer idleHarmony, idleLead;
 
-	LeadProcessor<SampleType> leadProcessor { harmonizer, state };
+	// the idle and pipeline buffers are budgeted for even when pipelining is off, so toggling it never grows the arena
+	static constexpr int numArenaChannels = PreHarmonyEffects<SampleType>::numArenaChannels
+										  + Harmonizer<SampleType>::numArenaChannels
+										  + LeadProcessor<SampleType>::numArenaChannels
+										  + PostHarmonyEffects<SampleType>::numArenaChannels
+										  + 4	 // idle
+										  + 6;	 // pipeline staging
 
-	PostHarmonyEffects<SampleType> postHarmonyEffects { state };
+	int	 silentChunks { 0 };
+	bool tailHasDecayed { false };
 };
 
 }  // namespace Imogen
@@ -2,10 +2,10 @@
 namespace Imogen
 {
 template <typename SampleType>
-Harmonizer<SampleType>::Harmonizer (State& stateToUse, Analyzer& analyzerToUse)
+Harmonizer<SampleType>::Harmonizer (State& stateToUse, Analyzer& analyzerToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse)
 	: dsp::LambdaSynth<SampleType> ([this]
 									{ return new Voice (*this, analyzer); }),
-	  analyzer (analyzerToUse), state (stateToUse)
+	  analyzer (analyzerToUse), state (stateToUse), snapshot (snapshotToUse), arena (arenaToUse)
 {
 	this->updateQuickReleaseMs (5);
 
@@ -14,59 +14,425 @@ Harmonizer<SampleType>::Harmonizer (State& stateToUse, Analyzer& analyzerToUse)
 }
 
 template <typename SampleType>
-void Harmonizer<SampleType>::prepared (double, int blocksize)
+Harmonizer<SampleType>::~Harmonizer()
 {
-	wetBuffer.setSize (2, blocksize, true, true, true);
+	this->cancelPendingUpdate();
+	this->stopTimer();
+
+	// the audio thread has stopped, so a layout it never took can be reclaimed like one it handed back
+	if (publishedLayout != nullptr)
+		retiredLayout.store (publishedLayout);
+
+	[[maybe_unused]] const auto reclaimed = reclaimPublishedLayout();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::prepared (double samplerate, int blocksize)
+{
+	arena.claim (wetBuffer, 2, blocksize);
+
+	this->voices.ensureStorageAllocated (maxVoices);
+	activeVoices.ensureStorageAllocated (maxVoices);
+	shedCandidates.ensureStorageAllocated (maxVoices);
+
+	bank->prepare (this->voices.size(), blocksize);
+
+	lastSamplerate		  = samplerate;
+	lastPreparedBlocksize = blocksize;
+
+	// picks up settings that were restored before the updaters were listening.
+	// A layout still waiting for the audio thread was built for the old settings, so it will be refused and built again
+	this->triggerAsyncUpdate();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::handleAsyncUpdate()
+{
+	if (renderPool == nullptr && internals.parallelVoiceRendering->get())
+	{
+		renderPool = std::make_unique<VoiceRenderPool> (static_cast<VoiceRenderPool::Client&> (*this), std::max (juce::SystemStats::getNumPhysicalCpus() - 1, 0));
+		livePool.store (renderPool.get(), std::memory_order_release);
+	}
+
+	changeVoiceCapacity();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::timerCallback()
+{
+	changeVoiceCapacity();
+}
+
+/*
+	Runs on the message thread. Only one layout is in flight at a time: until the audio thread has handed the last one back,
+	this does nothing and the timer calls it again. After that it frees the old voices and bank, and publishes a new layout
+	if the capacity still doesn't match. Nothing is allocated, freed or locked on the audio thread, and no chunk is skipped.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::changeVoiceCapacity()
+{
+	if (lastPreparedBlocksize == 0)
+		return;
+
+	if (! reclaimPublishedLayout())
+		return;
+
+	this->stopTimer();
+
+	const auto capacity = std::min (internals.voiceCapacity->get(), maxVoices);
+
+	// the audio thread only changes the voices when it takes a pending layout, and there isn't one now
+	const auto numVoices = this->voices.size();
+
+	if (capacity == numVoices)
+		return;
+
+	auto layout = std::make_unique<VoiceLayout>();
+
+	layout->samplerate = lastSamplerate;
+	layout->blocksize  = lastPreparedBlocksize;
+
+	layout->voices.ensureStorageAllocated (maxVoices);
+
+	for (auto i = 0; i < capacity; ++i)
+	{
+		if (i < numVoices)
+		{
+			layout->voices.add (this->voices.getUnchecked (i));
+			continue;
+		}
+
+		auto* voice = new Voice (*this, analyzer);
+		voice->prepare (lastSamplerate, lastPreparedBlocksize);
+		layout->voices.add (voice);
+	}
+
+	layout->bank = std::make_unique<VoiceBank<SampleType>>();
+	layout->bank->prepare (capacity, lastPreparedBlocksize);
+
+	publishedLayout = layout.release();
+	pendingLayout.store (publishedLayout, std::memory_order_release);
+
+	this->startTimer (reclaimIntervalMs);
+}
+
+/*
+	Called at the start of every chunk. The swaps only exchange pointers, and the kept voices carry their bank state across,
+	so a voice that was sleeping or shed stays that way. A layout built before the harmonizer was prepared again is handed back unused.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::takePendingLayout() noexcept
+{
+	auto* layout = pendingLayout.exchange (nullptr, std::memory_order_acquire);
+
+	if (layout == nullptr)
+		return;
+
+	if (layout->samplerate == lastSamplerate && layout->blocksize == lastPreparedBlocksize)
+	{
+		layout->bank->copyStateFrom (*bank);
+
+		this->voices.swapWith (layout->voices);
+		bank.swap (layout->bank);
+
+		// make sure the new voices are given the current settings
+		snapshot.markDirty (ParameterSnapshot::Group::adsr);
+		snapshot.markDirty (ParameterSnapshot::Group::harmonyMidi);
+	}
+
+	retiredLayout.store (layout, std::memory_order_release);
+}
+
+/*
+	Whichever voices the layout holds, the ones that aren't in the live set are deleted: after a swap those are the voices
+	that were removed, and in a refused layout they're the new voices that were never used. Returns false while the published
+	layout is still waiting for the audio thread.
+*/
+template <typename SampleType>
+bool Harmonizer<SampleType>::reclaimPublishedLayout()
+{
+	if (publishedLayout == nullptr)
+		return true;
+
+	if (retiredLayout.load (std::memory_order_acquire) != publishedLayout)
+		return false;
+
+	retiredLayout.store (nullptr, std::memory_order_relaxed);
+
+	std::unique_ptr<VoiceLayout> layout { std::exchange (publishedLayout, nullptr) };
+
+	for (auto* voice : layout->voices)
+		if (! this->voices.contains (voice))
+			delete voice;
+
+	layout->voices.clear (false);
+
+	return true;
 }
 
 template <typename SampleType>
 void Harmonizer<SampleType>::process (int numSamples, MidiBuffer& midiMessages,
-									  bool harmoniesBypassed)
+									  bool harmoniesBypassed, SampleType inputLevelToUse,
+									  AudioBuffer* renderTarget)
 {
+	inputLevel	= inputLevelToUse;
+	destination = renderTarget != nullptr ? renderTarget : &wetBuffer;
+
+	takePendingLayout();
+
 	if (harmoniesBypassed)
 	{
-		wetBuffer.clear();
+		destination->clear (0, numSamples);
 		this->bypassedBlock (numSamples, midiMessages);
 	}
 	else
 	{
 		updateParameters();
-		this->renderVoices (midiMessages, wetBuffer);
+
+		auto* pool = internals.parallelVoiceRendering->get() ? livePool.load (std::memory_order_acquire) : nullptr;
+
+		renderVoiceBank (midiMessages, numSamples, pool);
 	}
 
 	updateInternals();
 	lastBlocksize = numSamples;
 }
 
+/*
+	Serial and parallel rendering both come through here. The block is split at its MIDI events, and for each range
+	every active voice renders into its own scratch channels in the voice bank: on the pool's workers if there's a pool,
+	otherwise one after the other on this thread. Summing the scratch channels is also what measures the per-voice levels
+	that the audibility and load shedding decisions use, so both modes make those decisions the same way.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::renderVoiceBank (MidiBuffer& midiMessages, int numSamples, VoiceRenderPool* pool)
+{
+	auto startSample = 0;
+
+	for (const auto meta : midiMessages)
+	{
+		const auto samplePosition = juce::jlimit (startSample, numSamples, meta.samplePosition);
+
+		renderVoiceRange (startSample, samplePosition - startSample, pool);
+		this->processMidiEvent (meta.getMessage());
+
+		startSample = samplePosition;
+	}
+
+	renderVoiceRange (startSample, numSamples - startSample, pool);
+
+	if (pool != nullptr)
+		pool->endBlock();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::renderVoiceRange (int startSample, int numSamples, VoiceRenderPool* pool)
+{
+	if (numSamples <= 0)
+		return;
+
+	updateVoiceStates();
+
+	// the target is only cleared when there's no voice to overwrite it
+	if (activeVoices.isEmpty())
+	{
+		destination->clear (startSample, numSamples);
+		return;
+	}
+
+	rangeLength = numSamples;
+
+	if (pool != nullptr)
+	{
+		pool->run (activeVoices.size());
+	}
+	else
+	{
+		for (auto job = 0; job < activeVoices.size(); ++job)
+			renderJob (job);
+	}
+
+	// summing in voice order keeps the result independent of how the jobs were spread over the workers.
+	// A skipped voice may still be fading out, so it's summed, but it keeps the level it had before it was skipped
+	for (const auto voiceIndex : activeVoices)
+	{
+		auto* voice = static_cast<Voice*> (this->voices.getUnchecked (voiceIndex));
+
+		bank->accumulate (voiceIndex, *destination, startSample, numSamples, voiceIndex == activeVoices.getFirst(),
+						  voice->takeFade (numSamples, lastSamplerate), ! bank->isSkipped (voiceIndex));
+	}
+}
+
+/* Classifies every voice, decides which ones to skip, and puts the skipped ones to sleep. */
+template <typename SampleType>
+void Harmonizer<SampleType>::updateVoiceStates()
+{
+	using Stage = typename VoiceBank<SampleType>::Stage;
+
+	activeVoices.clearQuick();
+
+	for (auto i = 0; i < this->voices.size(); ++i)
+	{
+		auto* voice = static_cast<Voice*> (this->voices.getUnchecked (i));
+
+		if (! voice->isVoiceActive())
+		{
+			bank->setStage (i, Stage::off);
+			bank->clearFlags (i);
+
+			// a voice that's started by a note-on later in this block must be awake
+			voice->setDormant (false);
+			continue;
+		}
+
+		const auto stage = voice->isKeyDown() ? Stage::held : Stage::released;
+
+		bank->setStage (i, stage);
+
+		updateAudibility (i, stage);
+
+		activeVoices.add (i);
+	}
+
+	shedVoicesUnderLoad();
+
+	for (const auto voiceIndex : activeVoices)
+		static_cast<Voice*> (this->voices.getUnchecked (voiceIndex))->setDormant (bank->isSkipped (voiceIndex));
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::renderJob (int jobIndex)
+{
+	const auto voiceIndex = activeVoices.getUnchecked (jobIndex);
+
+	auto output = bank->getScratch (voiceIndex, rangeLength);
+
+	output.clear();
+
+	this->voices.getUnchecked (voiceIndex)->renderBlock (output);
+}
+
+/*
+	A released voice whose output has fallen far enough below the input level can't become audible again until it's retriggered,
+	so it fades out, stops running its shifter and only keeps its envelope moving. Pressing the key again wakes it with a short fade-in.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::updateAudibility (int voiceIndex, typename VoiceBank<SampleType>::Stage stage)
+{
+	using Flag = typename VoiceBank<SampleType>::Flag;
+
+	if (stage == VoiceBank<SampleType>::Stage::held)
+		bank->setFlag (voiceIndex, Flag::inaudible, false);
+	else if (! bank->hasFlag (voiceIndex, Flag::inaudible) && inputLevel > inputFloor)
+		bank->setFlag (voiceIndex, Flag::inaudible, bank->getLevel (voiceIndex) < inputLevel * inaudibleGain);
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::setLoadSheddingLevel (int newLevel) noexcept
+{
+	loadSheddingLevel = newLevel;
+}
+
+/*
+	Under CPU pressure, voices are skipped in order of how little they'd be missed.
+	The first step drops voices that are already quiet relative to the input. Each further step drops two more voices,
+	following the same priorities as note stealing: the lowest and highest notes are always kept, released voices go before held ones,
+	and softer voices go before louder ones.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::shedVoicesUnderLoad()
+{
+	using Flag  = typename VoiceBank<SampleType>::Flag;
+	using Stage = typename VoiceBank<SampleType>::Stage;
+
+	for (const auto voiceIndex : activeVoices)
+		bank->setFlag (voiceIndex, Flag::shed, false);
+
+	if (loadSheddingLevel == 0 || activeVoices.size() < 3)
+		return;
+
+	auto lowestNote	 = 128;
+	auto highestNote = -1;
+
+	for (const auto voiceIndex : activeVoices)
+	{
+		const auto note = this->voices.getUnchecked (voiceIndex)->getCurrentlyPlayingNote();
+
+		lowestNote	= std::min (lowestNote, note);
+		highestNote = std::max (highestNote, note);
+	}
+
+	shedCandidates.clearQuick();
+
+	for (const auto voiceIndex : activeVoices)
+	{
+		if (bank->hasFlag (voiceIndex, Flag::inaudible))
+			continue;
+
+		const auto note = this->voices.getUnchecked (voiceIndex)->getCurrentlyPlayingNote();
+
+		if (note == lowestNote || note == highestNote)
+			continue;
+
+		if (inputLevel > inputFloor && bank->getLevel (voiceIndex) < inputLevel * quietGain)
+			bank->setFlag (voiceIndex, Flag::shed, true);
+		else
+			shedCandidates.add (voiceIndex);
+	}
+
+	const auto numToShed = std::min ((loadSheddingLevel - 1) * 2, shedCandidates.size());
+
+	if (numToShed <= 0)
+		return;
+
+	std::sort (shedCandidates.begin(), shedCandidates.end(), [this] (int a, int b)
+			   {
+				   const auto aReleased = bank->getStage (a) == Stage::released;
+				   const auto bReleased = bank->getStage (b) == Stage::released;
+
+				   if (aReleased != bReleased)
+					   return aReleased && ! bReleased;
+
+				   return bank->getLevel (a) < bank->getLevel (b);
+			   });
+
+	for (auto i = 0; i < numToShed; ++i)
+		bank->setFlag (shedCandidates.getUnchecked (i), Flag::shed, true);
+}
+
 template <typename SampleType>
 void Harmonizer<SampleType>::updateParameters()
 {
-	this->setMidiLatch (midi.midiLatch->get());
+	using Group = ParameterSnapshot::Group;
+
+	if (snapshot.consume (Group::adsr))
+	{
+		const auto& adsr = snapshot.adsr;
+
+		this->updateADSRsettings (adsr.attack, adsr.decay, adsr.sustain, adsr.release);
+	}
 
-	this->updateADSRsettings (midi.adsrAttack->get(),
-							  midi.adsrDecay->get(),
-							  static_cast<float> (midi.adsrSustain->get()) * 0.01f,
-							  midi.adsrRelease->get());
+	if (! snapshot.consume (Group::harmonyMidi))
+		return;
 
-	this->pedal.setParams (midi.pedalToggle->get(),
-						   midi.pedalThresh->get(),
-						   midi.pedalInterval->get());
+	const auto& settings = snapshot.harmonyMidi;
 
-	this->descant.setParams (midi.descantToggle->get(),
-							 midi.descantThresh->get(),
-							 midi.descantInterval->get());
+	this->setMidiLatch (settings.latch);
 
-	this->setNoteStealingEnabled (midi.voiceStealing->get());
-	this->setAftertouchGainOnOff (midi.aftertouchToggle->get());
+	this->pedal.setParams (settings.pedal, settings.pedalThresh, settings.pedalInterval);
+	this->descant.setParams (settings.descant, settings.descantThresh, settings.descantInterval);
 
-	this->updateMidiVelocitySensitivity (midi.velocitySens->get());
+	this->setNoteStealingEnabled (settings.stealing);
+	this->setAftertouchGainOnOff (settings.aftertouch);
 
-	this->updatePitchbendRange (midi.pitchbendRange->get());
+	this->updateMidiVelocitySensitivity (settings.velocitySens);
 
-	this->panner.setLowestNote (parameters.lowestPanned->get());
+	this->updatePitchbendRange (settings.pitchbendRange);
 
-	this->togglePitchGlide (midi.pitchGlide->get());
-	this->setPitchGlideTime (static_cast<double> (midi.glideTime->get()));
+	this->panner.setLowestNote (settings.lowestPanned);
+
+	this->togglePitchGlide (settings.glide);
+	this->setPitchGlideTime (static_cast<double> (settings.glideTime));
 }
 
 template <typename SampleType>
@@ -79,10 +445,26 @@ void Harmonizer<SampleType>::updateInternals()
 	//    internals.mtsEspScaleName->set (this->getScaleName());
 }
 
+template <typename SampleType>
+size_t Harmonizer<SampleType>::getVoiceBankSizeInBytes() const noexcept
+{
+	return bank->getSizeInBytes();
+}
+
+template <typename SampleType>
+bool Harmonizer<SampleType>::isSounding() const noexcept
+{
+	for (const auto* voice : this->voices)
+		if (voice->isVoiceActive())
+			return true;
+
+	return false;
+}
+
 template <typename SampleType>
 AudioBuffer<SampleType>& Harmonizer<SampleType>::getHarmonySignal()
 {
-	alias.setDataToReferTo (wetBuffer.getArrayOfWritePointers(), 2, lastBlocksize);
+	alias.setDataToReferTo (destination->getArrayOfWritePointers(), 2, lastBlocksize);
 	return alias;
 }
 
@@ -5,12 +5,17 @@
 #include <lemons_psola/lemons_psola.h>
 
 #include "HarmonizerVoice.h"
+#include "VoiceRenderPool.h"
+#include "VoiceBank.h"
+
+#include <imogen_dsp/Engine/ParameterSnapshot.h>
+#include <imogen_dsp/Engine/Utils/AudioArena.h>
 
 
 namespace Imogen
 {
 template <typename SampleType>
-class Harmonizer : public dsp::LambdaSynth<SampleType>
+class Harmonizer : public dsp::LambdaSynth<SampleType>, private VoiceRenderPool::Client, private juce::AsyncUpdater, private juce::Timer
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 	using Voice		  = HarmonizerVoice<SampleType>;
@@ -18,14 +23,29 @@ class Harmonizer : public dsp::LambdaSynth<SampleType>
 
 public:
 
-	Harmonizer (State& stateToUse, Analyzer& analyzerToUse);
+	Harmonizer (State& stateToUse, Analyzer& analyzerToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse);
+
+	~Harmonizer() override;
 
-	void process (int		  numSamples,
-				  MidiBuffer& midiMessages,
-				  bool		  harmoniesBypassed);
+	/* If renderTarget is null, the voices are summed into the harmonizer's own buffer. */
+	void process (int		   numSamples,
+				  MidiBuffer&  midiMessages,
+				  bool		   harmoniesBypassed,
+				  SampleType   inputLevelToUse,
+				  AudioBuffer* renderTarget);
 
 	AudioBuffer& getHarmonySignal();
 
+	bool isSounding() const noexcept;
+
+	void setLoadSheddingLevel (int newLevel) noexcept;
+
+	size_t getVoiceBankSizeInBytes() const noexcept;
+
+	static constexpr int numArenaChannels = 2;
+
+	static constexpr int maxVoices = 64;
+
 	Analyzer& analyzer;
 
 private:
@@ -35,15 +55,81 @@ private:
 	void updateParameters();
 	void updateInternals();
 
+	/*
+		A complete set of voices and a bank sized for them. The message thread builds one when the voice capacity changes,
+		reusing the voices that are kept, and publishes it. The audio thread swaps it in whole at the start of its next chunk
+		and hands back the layout, now holding the old set, for the message thread to delete whatever is no longer used.
+	*/
+	struct VoiceLayout
+	{
+		decltype (Harmonizer::voices)		   voices;
+		std::unique_ptr<VoiceBank<SampleType>> bank;
+
+		double samplerate { 0. };
+		int	   blocksize { 0 };
+	};
+
+	void changeVoiceCapacity();
+
+	void takePendingLayout() noexcept;
+
+	[[nodiscard]] bool reclaimPublishedLayout();
+
+	void timerCallback() final;
+
+	void renderVoiceBank (MidiBuffer& midiMessages, int numSamples, VoiceRenderPool* pool);
+	void renderVoiceRange (int startSample, int numSamples, VoiceRenderPool* pool);
+	void renderJob (int jobIndex) final;
+
+	void updateVoiceStates();
+
+	void handleAsyncUpdate() final;
+
+	void updateAudibility (int voiceIndex, typename VoiceBank<SampleType>::Stage stage);
+	void shedVoicesUnderLoad();
+
+	static constexpr auto inaudibleGain = SampleType (0.0001);	// -80 dB
+	static constexpr auto quietGain		= SampleType (0.01);	// -40 dB
+	static constexpr auto inputFloor	= SampleType (0.001);	// -60 dB
+
 	State&		state;
-	Parameters& parameters { state.parameters };
-	MidiState&	midi { parameters.midiState };
-	Internals&	internals { state.internals };
+	Internals& internals { state.internals };
 
-	AudioBuffer wetBuffer;
-	AudioBuffer alias;
+	ParameterSnapshot&		snapshot;
+	AudioArena<SampleType>& arena;
+
+	AudioBuffer	 wetBuffer;
+	AudioBuffer	 alias;
+	AudioBuffer* destination { &wetBuffer };
 
 	int lastBlocksize { 0 };
+
+	std::unique_ptr<VoiceBank<SampleType>> bank { std::make_unique<VoiceBank<SampleType>>() };
+
+	juce::Array<int> activeVoices, shedCandidates;
+	int				 rangeLength { 0 };
+	SampleType		 inputLevel { 0 };
+	int				 loadSheddingLevel { 0 };
+
+	std::atomic<VoiceLayout*> pendingLayout { nullptr }, retiredLayout { nullptr };
+
+	// only touched on the message thread: the layout that was last published and hasn't been reclaimed yet
+	VoiceLayout* publishedLayout { nullptr };
+
+	static constexpr int reclaimIntervalMs = 20;
+
+	double lastSamplerate { 0. };
+	int	   lastPreparedBlocksize { 0 };
+
+	plugin::ParamUpdater capacityUpdater { internals.voiceCapacity, [&]
+										   { this->triggerAsyncUpdate(); } };
+
+	plugin::ParamUpdater parallelRenderingUpdater { internals.parallelVoiceRendering, [&]
+													{ this->triggerAsyncUpdate(); } };
+
+	// created on the message thread the first time parallel rendering is switched on, then kept until the harmonizer is destroyed
+	std::unique_ptr<VoiceRenderPool> renderPool;
+	std::atomic<VoiceRenderPool*>	 livePool { nullptr };
 };
 
 
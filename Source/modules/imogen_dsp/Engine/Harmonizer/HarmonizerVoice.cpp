@@ -7,15 +7,53 @@ HarmonizerVoice<SampleType>::HarmonizerVoice (Harmonizer<SampleType>& h, dsp::ps
 {
 }
 
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::setDormant (bool shouldBeDormant) noexcept
+{
+	dormant = shouldBeDormant;
+}
+
 template <typename SampleType>
 void HarmonizerVoice<SampleType>::renderPlease (AudioBuffer& output, float desiredFrequency, double currentSamplerate)
 {
 	jassert (desiredFrequency > 0 && currentSamplerate > 0);
 
+	// once its fade-out has finished, a dormant voice skips the shifter and lets the envelope run on silence
+	if (isDormant())
+	{
+		output.clear();
+		return;
+	}
+
 	shifter.setPitch (desiredFrequency, currentSamplerate);
 	shifter.getSamples (output);
 }
 
+template <typename SampleType>
+typename VoiceBank<SampleType>::GainRamp HarmonizerVoice<SampleType>::takeFade (int numSamples, double samplerate) noexcept
+{
+	static constexpr auto fadeSeconds = 0.005;
+
+	const auto target = dormant ? SampleType (0) : SampleType (1);
+
+	if (fadeGain == target)
+		return { fadeGain, fadeGain, 0 };
+
+	const auto step		  = 1. / juce::jmax (1., samplerate * fadeSeconds);
+	const auto fadeLength = juce::roundToInt (std::abs (static_cast<double> (target - fadeGain)) / step);
+	const auto rampLength = juce::jmin (numSamples, fadeLength);
+
+	const auto endGain = rampLength == fadeLength
+						   ? target
+						   : fadeGain + (target - fadeGain) * static_cast<SampleType> (rampLength) / static_cast<SampleType> (fadeLength);
+
+	const typename VoiceBank<SampleType>::GainRamp ramp { fadeGain, endGain, rampLength };
+
+	fadeGain = endGain;
+
+	return ramp;
+}
+
 template class HarmonizerVoice<float>;
 template class HarmonizerVoice<double>;
 
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include "VoiceBank.h"
+
 
 namespace Imogen
 {
@@ -19,11 +21,22 @@ public:
 
 	HarmonizerVoice (Harmonizer<SampleType>& h, dsp::psola::Analyzer<SampleType>& analyzerToUse);
 
+	/* Going dormant fades the voice out first, and waking it fades it back in, so neither clicks. */
+	void setDormant (bool shouldBeDormant) noexcept;
+
+	bool isDormant() const noexcept { return dormant && fadeGain == SampleType (0); }
+
+	/* Moves the fade on by one range and returns the gain ramp the voice bank applies to it as it sums the voice. */
+	typename VoiceBank<SampleType>::GainRamp takeFade (int numSamples, double samplerate) noexcept;
+
 private:
 
 	void renderPlease (AudioBuffer& output, float desiredFrequency, double currentSamplerate) final;
 
 	dsp::psola::Shifter<SampleType> shifter;
+
+	bool	   dormant { false };
+	SampleType fadeGain { 1 };
 };
 
 
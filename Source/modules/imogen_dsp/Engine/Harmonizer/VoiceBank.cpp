@@ -0,0 +1,193 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void VoiceBank<SampleType>::prepare (int numVoices, int blocksize)
+{
+	static constexpr auto samplesPerLine = static_cast<int> (alignment / sizeof (SampleType));
+	static constexpr auto intsPerLine	 = static_cast<int> (alignment / sizeof (int));
+
+	capacity = numVoices;
+
+	const auto channelStride = roundUp (blocksize, samplesPerLine);
+	const auto numChannels	 = capacity * 2;
+
+	const auto scratchBytes = sizeof (SampleType) * static_cast<size_t> (numChannels * channelStride);
+	const auto levelBytes	= sizeof (SampleType) * static_cast<size_t> (roundUp (capacity, samplesPerLine));
+	const auto stageBytes	= sizeof (int) * static_cast<size_t> (roundUp (capacity, intsPerLine));
+	const auto totalBytes	= scratchBytes + levelBytes + stageBytes * 2;
+
+	memory.allocate (alignment + totalBytes, true);
+	sizeInBytes = alignment + totalBytes;
+
+	void* start = memory.get();
+	auto  space = alignment + totalBytes;
+	std::align (alignment, totalBytes, start, space);
+
+	auto* scratch = static_cast<SampleType*> (start);
+
+	channels.resize (static_cast<size_t> (numChannels));
+
+	for (auto chan = 0; chan < numChannels; ++chan)
+		channels[static_cast<size_t> (chan)] = scratch + chan * channelStride;
+
+	levels = reinterpret_cast<SampleType*> (static_cast<std::byte*> (start) + scratchBytes);
+	stages = reinterpret_cast<int*> (static_cast<std::byte*> (start) + scratchBytes + levelBytes);
+	flags  = reinterpret_cast<int*> (static_cast<std::byte*> (start) + scratchBytes + levelBytes + stageBytes);
+
+	// voices count as audible until they've been measured
+	juce::FloatVectorOperations::fill (levels, SampleType (1), capacity);
+}
+
+template <typename SampleType>
+void VoiceBank<SampleType>::copyStateFrom (const VoiceBank& other) noexcept
+{
+	const auto numVoices = std::min (capacity, other.capacity);
+
+	std::copy (other.levels, other.levels + numVoices, levels);
+	std::copy (other.stages, other.stages + numVoices, stages);
+	std::copy (other.flags, other.flags + numVoices, flags);
+}
+
+template <typename SampleType>
+juce::AudioBuffer<SampleType> VoiceBank<SampleType>::getScratch (int voiceIndex, int numSamples) const
+{
+	jassert (voiceIndex >= 0 && voiceIndex < capacity);
+
+	return { channels.data() + voiceIndex * 2, 2, numSamples };
+}
+
+template <typename SampleType>
+void VoiceBank<SampleType>::setStage (int voiceIndex, Stage stage) noexcept
+{
+	stages[voiceIndex] = static_cast<int> (stage);
+}
+
+template <typename SampleType>
+typename VoiceBank<SampleType>::Stage VoiceBank<SampleType>::getStage (int voiceIndex) const noexcept
+{
+	return static_cast<Stage> (stages[voiceIndex]);
+}
+
+template <typename SampleType>
+void VoiceBank<SampleType>::setFlag (int voiceIndex, Flag flag, bool shouldBeSet) noexcept
+{
+	if (shouldBeSet)
+		flags[voiceIndex] |= static_cast<int> (flag);
+	else
+		flags[voiceIndex] &= ~static_cast<int> (flag);
+}
+
+template <typename SampleType>
+bool VoiceBank<SampleType>::hasFlag (int voiceIndex, Flag flag) const noexcept
+{
+	return (flags[voiceIndex] & static_cast<int> (flag)) != 0;
+}
+
+template <typename SampleType>
+void VoiceBank<SampleType>::clearFlags (int voiceIndex) noexcept
+{
+	flags[voiceIndex] = 0;
+}
+
+template <typename SampleType>
+bool VoiceBank<SampleType>::isSkipped (int voiceIndex) const noexcept
+{
+	return flags[voiceIndex] != 0;
+}
+
+template <typename SampleType>
+SampleType VoiceBank<SampleType>::getLevel (int voiceIndex) const noexcept
+{
+	return levels[voiceIndex];
+}
+
+/*
+	Sums a voice into the output, applies its fade and measures its level in the same pass over its scratch channels,
+	so each voice's samples are only read once after it has rendered. The first voice in a range overwrites the output,
+	so the harmonizer never has to clear its target first.
+*/
+template <typename SampleType>
+void VoiceBank<SampleType>::accumulate (int voiceIndex, AudioBuffer& output, int startSample, int numSamples,
+										bool isFirstVoice, GainRamp gain, bool updateLevel) noexcept
+{
+	if (numSamples <= 0)
+		return;
+
+	// a voice that has faded out completely adds nothing, so its samples aren't read at all
+	if (gain.start == SampleType (0) && gain.end == SampleType (0) && ! updateLevel)
+	{
+		if (isFirstVoice)
+			output.clear (startSample, numSamples);
+
+		return;
+	}
+
+	const auto sumOfSquares = isFirstVoice ? sumInto<true> (voiceIndex, output, startSample, numSamples, gain)
+										   : sumInto<false> (voiceIndex, output, startSample, numSamples, gain);
+
+	if (updateLevel)
+		levels[voiceIndex] = std::sqrt (sumOfSquares / static_cast<SampleType> (numSamples * 2));
+}
+
+template <typename SampleType>
+template <bool overwrite>
+SampleType VoiceBank<SampleType>::sumInto (int voiceIndex, AudioBuffer& output, int startSample, int numSamples, GainRamp gain) const noexcept
+{
+	SampleType sumsOfSquares[4] = {};
+
+	const auto rampLength = std::min (gain.rampLength, numSamples);
+	const auto increment  = rampLength > 0 ? (gain.end - gain.start) / static_cast<SampleType> (rampLength) : SampleType (0);
+
+	for (auto chan = 0; chan < 2; ++chan)
+	{
+		auto*		dest = output.getWritePointer (chan, startSample);
+		const auto* src	 = channels[static_cast<size_t> (voiceIndex * 2 + chan)];
+
+		mixSegment<overwrite> (dest, src, rampLength, gain.start, increment, sumsOfSquares);
+		mixSegment<overwrite> (dest + rampLength, src + rampLength, numSamples - rampLength, gain.end, SampleType (0), sumsOfSquares);
+	}
+
+	return (sumsOfSquares[0] + sumsOfSquares[1]) + (sumsOfSquares[2] + sumsOfSquares[3]);
+}
+
+template <typename SampleType>
+template <bool overwrite>
+void VoiceBank<SampleType>::mixSegment (SampleType* dest, const SampleType* src, int numSamples,
+										SampleType gain, SampleType increment, SampleType (&sumsOfSquares)[4]) noexcept
+{
+	auto i = 0;
+
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		for (auto lane = 0; lane < 4; ++lane)
+		{
+			const auto sample = src[i + lane];
+			const auto scaled = sample * (gain + increment * static_cast<SampleType> (i + lane));
+
+			if constexpr (overwrite)
+				dest[i + lane] = scaled;
+			else
+				dest[i + lane] += scaled;
+
+			sumsOfSquares[lane] += sample * sample;
+		}
+	}
+
+	for (; i < numSamples; ++i)
+	{
+		const auto scaled = src[i] * (gain + increment * static_cast<SampleType> (i));
+
+		if constexpr (overwrite)
+			dest[i] = scaled;
+		else
+			dest[i] += scaled;
+
+		sumsOfSquares[0] += src[i] * src[i];
+	}
+}
+
+template class VoiceBank<float>;
+template class VoiceBank<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,91 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	Keeps the per-voice render state the harmonizer touches every block in contiguous, cache-line aligned arrays:
+	one allocation holds every voice's stereo scratch channels, followed by the per-voice state arrays.
+*/
+template <typename SampleType>
+class VoiceBank
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	enum class Stage : int
+	{
+		off = 0,
+		held,
+		released
+	};
+
+	enum class Flag : int
+	{
+		inaudible = 1,
+		shed	  = 2
+	};
+
+	/* A gain that moves linearly from start to end over the first rampLength samples of a range, then holds at end. */
+	struct GainRamp
+	{
+		SampleType start { 1 }, end { 1 };
+		int		   rampLength { 0 };
+	};
+
+	void prepare (int numVoices, int blocksize);
+
+	int getCapacity() const noexcept { return capacity; }
+
+	size_t getSizeInBytes() const noexcept { return sizeInBytes; }
+
+	/* Takes over the stages, flags and levels of the voices both banks have, so a bank can replace another mid-note. */
+	void copyStateFrom (const VoiceBank& other) noexcept;
+
+	AudioBuffer getScratch (int voiceIndex, int numSamples) const;
+
+	void  setStage (int voiceIndex, Stage stage) noexcept;
+	Stage getStage (int voiceIndex) const noexcept;
+
+	void setFlag (int voiceIndex, Flag flag, bool shouldBeSet) noexcept;
+	bool hasFlag (int voiceIndex, Flag flag) const noexcept;
+	void clearFlags (int voiceIndex) noexcept;
+
+	/* True if any flag says this voice shouldn't run its shifter. */
+	bool isSkipped (int voiceIndex) const noexcept;
+
+	SampleType getLevel (int voiceIndex) const noexcept;
+
+	/*
+		Adds the voice's scratch channels into the output with the gain applied, or for the first voice summed into a range, overwrites it.
+		Unless told not to, stores their RMS before the gain as the voice's level.
+	*/
+	void accumulate (int voiceIndex, AudioBuffer& output, int startSample, int numSamples,
+					 bool isFirstVoice, GainRamp gain = {}, bool updateLevel = true) noexcept;
+
+	static constexpr size_t alignment = 64;
+
+private:
+
+	static constexpr int roundUp (int value, int multiple) noexcept { return (value + multiple - 1) / multiple * multiple; }
+
+	template <bool overwrite>
+	SampleType sumInto (int voiceIndex, AudioBuffer& output, int startSample, int numSamples, GainRamp gain) const noexcept;
+
+	template <bool overwrite>
+	static void mixSegment (SampleType* dest, const SampleType* src, int numSamples,
+							SampleType gain, SampleType increment, SampleType (&sumsOfSquares)[4]) noexcept;
+
+	juce::HeapBlock<std::byte> memory;
+
+	std::vector<SampleType*> channels;
+
+	SampleType* levels { nullptr };
+	int*		stages { nullptr };
+	int*		flags { nullptr };
+
+	int	   capacity { 0 };
+	size_t sizeInBytes { 0 };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,148 @@
+
+namespace Imogen
+{
+void VoiceRenderPool::JobQueue::reset (int begin, int end) noexcept
+{
+	cursor.store ((static_cast<std::uint64_t> (end) << 32) | static_cast<std::uint32_t> (begin),
+				  std::memory_order_release);
+}
+
+int VoiceRenderPool::JobQueue::claim() noexcept
+{
+	// the next and end indices share one atomic, so a claim can never see a half-reset queue
+	const auto prev = cursor.fetch_add (1, std::memory_order_acq_rel);
+
+	const auto next = static_cast<int> (prev & 0xffffffff);
+	const auto end	= static_cast<int> (prev >> 32);
+
+	if (next < end)
+		return next;
+
+	return -1;
+}
+
+
+VoiceRenderPool::VoiceRenderPool (Client& clientToUse, int numWorkerThreads)
+	: client (clientToUse), queues (static_cast<size_t> (std::max (numWorkerThreads, 0) + 1))
+{
+	threads.reserve (queues.size() - 1);
+
+	for (auto i = 1; i < static_cast<int> (queues.size()); ++i)
+		threads.emplace_back ([this, i]
+							  { workerLoop (i); });
+}
+
+VoiceRenderPool::~VoiceRenderPool()
+{
+	shouldExit.store (true, std::memory_order_release);
+	blockIsOpen.store (false, std::memory_order_release);
+
+	blockGeneration.fetch_add (1, std::memory_order_release);
+	blockGeneration.notify_all();
+
+	for (auto& thread : threads)
+		thread.join();
+}
+
+void VoiceRenderPool::run (int numJobs)
+{
+	if (numJobs <= 0)
+		return;
+
+	const auto numQueues = static_cast<int> (queues.size());
+
+	if (numQueues == 1 || numJobs == 1)
+	{
+		for (auto i = 0; i < numJobs; ++i)
+			client.renderJob (i);
+
+		return;
+	}
+
+	jobsRemaining.store (numJobs, std::memory_order_relaxed);
+
+	for (auto q = 0; q < numQueues; ++q)
+		queues[static_cast<size_t> (q)].reset (numJobs * q / numQueues, numJobs * (q + 1) / numQueues);
+
+	const auto previousRun = runGeneration.fetch_add (1, std::memory_order_release);
+
+	if (! blockIsOpen.load (std::memory_order_relaxed))
+		beginBlock (previousRun);
+
+	processJobs (0);
+
+	// by now the only jobs left are already running on a worker, so this waits for at most one voice's render
+	while (jobsRemaining.load (std::memory_order_acquire) > 0)
+		pauseWhileSpinning();
+}
+
+void VoiceRenderPool::beginBlock (std::uint32_t previousRun) noexcept
+{
+	runBeforeBlock.store (previousRun, std::memory_order_relaxed);
+	blockIsOpen.store (true, std::memory_order_relaxed);
+
+	blockGeneration.fetch_add (1, std::memory_order_release);
+	blockGeneration.notify_all();
+}
+
+void VoiceRenderPool::endBlock() noexcept
+{
+	blockIsOpen.store (false, std::memory_order_release);
+}
+
+void VoiceRenderPool::processJobs (int queueIndex)
+{
+	const auto numQueues = static_cast<int> (queues.size());
+
+	for (auto offset = 0; offset < numQueues; ++offset)
+	{
+		auto& queue = queues[static_cast<size_t> ((queueIndex + offset) % numQueues)];
+
+		for (auto job = queue.claim(); job >= 0; job = queue.claim())
+		{
+			client.renderJob (job);
+			jobsRemaining.fetch_sub (1, std::memory_order_release);
+		}
+	}
+}
+
+void VoiceRenderPool::workerLoop (int queueIndex)
+{
+	promoteCurrentThreadToRealtime();
+
+	auto seenBlock = blockGeneration.load (std::memory_order_acquire);
+
+	while (true)
+	{
+		blockGeneration.wait (seenBlock, std::memory_order_acquire);
+		seenBlock = blockGeneration.load (std::memory_order_acquire);
+
+		if (shouldExit.load (std::memory_order_acquire))
+			return;
+
+		const RealtimeScope realtimeScope;
+
+		auto seenRun = runBeforeBlock.load (std::memory_order_relaxed);
+
+		while (true)
+		{
+			auto latestRun = runGeneration.load (std::memory_order_acquire);
+
+			while (latestRun == seenRun && blockIsOpen.load (std::memory_order_acquire))
+			{
+				pauseWhileSpinning();
+				latestRun = runGeneration.load (std::memory_order_acquire);
+			}
+
+			if (latestRun == seenRun)
+				break;
+
+			seenRun = latestRun;
+
+			// a worker that wakes late, or sees a run that has already finished, just finds the queues empty
+			processJobs (queueIndex);
+		}
+	}
+}
+
+}  // namespace Imogen
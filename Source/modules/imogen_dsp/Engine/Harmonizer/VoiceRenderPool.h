@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <imogen_dsp/Engine/Utils/RealtimeThread.h>
+#include <imogen_dsp/Engine/Utils/RealtimeSentinel.h>
+
+namespace Imogen
+{
+/*
+	A fixed set of pre-spawned worker threads that render a block's voices in parallel.
+	Each call to run() splits the jobs evenly between the calling thread and the workers;
+	a thread that finishes its own share steals the remaining jobs from the others.
+
+	The workers are woken once per block, by the first run() after endBlock(). Until the next endBlock() they spin
+	between runs, so the sub-ranges a block is split into at its MIDI events don't each cost a wake-up.
+	Apart from that one wake-up, nothing here locks, allocates or makes a system call on the calling thread.
+*/
+class VoiceRenderPool
+{
+public:
+
+	struct Client
+	{
+		virtual ~Client() = default;
+
+		virtual void renderJob (int jobIndex) = 0;
+	};
+
+	VoiceRenderPool (Client& clientToUse, int numWorkerThreads);
+
+	~VoiceRenderPool();
+
+	void run (int numJobs);
+
+	/* Sends the workers back to sleep. Call this at the end of every block that called run(). */
+	void endBlock() noexcept;
+
+	int getNumWorkers() const noexcept { return static_cast<int> (threads.size()); }
+
+private:
+
+	struct alignas (64) JobQueue
+	{
+		void reset (int begin, int end) noexcept;
+
+		[[nodiscard]] int claim() noexcept;
+
+		std::atomic<std::uint64_t> cursor { 0 };
+	};
+
+	void beginBlock (std::uint32_t firstRun) noexcept;
+
+	void workerLoop (int queueIndex);
+
+	void processJobs (int queueIndex);
+
+	Client& client;
+
+	std::vector<JobQueue>	 queues;
+	std::vector<std::thread> threads;
+
+	alignas (64) std::atomic<std::uint32_t> blockGeneration { 0 };
+	alignas (64) std::atomic<std::uint32_t> runGeneration { 0 };
+	alignas (64) std::atomic<int> jobsRemaining { 0 };
+
+	std::atomic<std::uint32_t> runBeforeBlock { 0 };
+	std::atomic<bool>		   blockIsOpen { false }, shouldExit { false };
+};
+
+}  // namespace Imogen
@@ -15,8 +15,17 @@ void DryPanner<SampleType>::process (const AudioBuffer& monoIn, AudioBuffer& ste
 	}
 	else
 	{
-		panner.setMidiPan (parameters.leadPan->get());
-		panner.process (monoIn, stereoOut);
+		const auto pan = parameters.leadPan->get();
+
+		forEachAutomationSlice (lastPan, pan, monoIn.getNumSamples(), [&] (int startSample, int numSamples, int value)
+								{
+									auto outSlice = sliceOf (stereoOut, startSample, numSamples);
+
+									panner.setMidiPan (value);
+									panner.process (sliceOf (monoIn, startSample, numSamples), outSlice);
+								});
+
+		lastPan = pan;
 	}
 }
 
@@ -24,6 +33,7 @@ template <typename SampleType>
 void DryPanner<SampleType>::prepare (double samplerate, int blocksize)
 {
 	panner.prepare (samplerate, blocksize);
+	lastPan = parameters.leadPan->get();
 }
 
 template struct DryPanner<float>;
@@ -18,6 +18,8 @@ private:
 	Parameters& parameters;
 
 	dsp::FX::MonoToStereoPanner<SampleType> panner;
+
+	int lastPan { 64 };
 };
 
 }  // namespace Imogen
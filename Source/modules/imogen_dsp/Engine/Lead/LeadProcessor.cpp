@@ -2,15 +2,15 @@
 namespace Imogen
 {
 template <typename SampleType>
-LeadProcessor<SampleType>::LeadProcessor (Harmonizer<SampleType>& harm, State& stateToUse)
-	: pitchCorrector (harm, stateToUse.internals), dryPanner (stateToUse.parameters)
+LeadProcessor<SampleType>::LeadProcessor (Harmonizer<SampleType>& harm, State& stateToUse, AudioArena<SampleType>& arenaToUse)
+	: pitchCorrector (harm, stateToUse.internals, arenaToUse), dryPanner (stateToUse.parameters), arena (arenaToUse)
 {
 }
 
 template <typename SampleType>
 void LeadProcessor<SampleType>::prepare (double samplerate, int blocksize)
 {
-	pannedLeadBuffer.setSize (2, blocksize, true, true, true);
+	arena.claim (pannedLeadBuffer, 2, blocksize);
 
 	dryPanner.prepare (samplerate, blocksize);
 	pitchCorrector.prepare (samplerate, blocksize);
@@ -19,9 +19,17 @@ void LeadProcessor<SampleType>::prepare (double samplerate, int blocksize)
 template <typename SampleType>
 void LeadProcessor<SampleType>::process (bool leadIsBypassed, int numSamples)
 {
-	pitchCorrector.renderNextFrame (numSamples);
-	dryPanner.process (pitchCorrector.getCorrectedSignal(), pannedLeadBuffer, leadIsBypassed);
 	lastBlocksize = numSamples;
+
+	// nothing downstream hears the corrected lead while it's bypassed, so the shifter doesn't run
+	if (leadIsBypassed)
+	{
+		pannedLeadBuffer.clear();
+		return;
+	}
+
+	pitchCorrector.renderNextFrame (numSamples);
+	dryPanner.process (pitchCorrector.getCorrectedSignal(), pannedLeadBuffer, false);
 }
 
 template <typename SampleType>
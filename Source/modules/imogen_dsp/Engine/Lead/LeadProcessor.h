@@ -4,6 +4,8 @@
 #include "PitchCorrector.h"
 #include "DryPanner.h"
 
+#include <imogen_dsp/Engine/Utils/AutomationSlices.h>
+
 namespace Imogen
 {
 template <typename SampleType>
@@ -15,7 +17,7 @@ public:
 	using Analyzer	  = dsp::psola::Analyzer<SampleType>;
 	using Synth		  = dsp::SynthBase<SampleType>;
 
-	LeadProcessor (Harmonizer<SampleType>& harm, State& stateToUse);
+	LeadProcessor (Harmonizer<SampleType>& harm, State& stateToUse, AudioArena<SampleType>& arenaToUse);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -23,11 +25,15 @@ public:
 
 	AudioBuffer& getProcessedSignal();
 
+	static constexpr int numArenaChannels = 2 + PitchCorrection<SampleType>::numArenaChannels;
+
 private:
 
 	PitchCorrection<SampleType> pitchCorrector;
 	DryPanner<SampleType>		dryPanner;
 
+	AudioArena<SampleType>& arena;
+
 	AudioBuffer pannedLeadBuffer;
 	AudioBuffer alias;
 
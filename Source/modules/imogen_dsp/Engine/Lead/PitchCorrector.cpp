@@ -2,8 +2,8 @@
 namespace Imogen
 {
 template <typename SampleType>
-PitchCorrection<SampleType>::PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse)
-	: Base (harm.analyzer, harm.getPitchAdjuster()), internals (internalsToUse)
+PitchCorrection<SampleType>::PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse, AudioArena<SampleType>& arenaToUse)
+	: Base (harm.analyzer, harm.getPitchAdjuster()), internals (internalsToUse), arena (arenaToUse)
 {
 }
 
@@ -27,7 +27,7 @@ const juce::AudioBuffer<SampleType>& PitchCorrection<SampleType>::getCorrectedSi
 template <typename SampleType>
 void PitchCorrection<SampleType>::prepare (double samplerate, int blocksize)
 {
-	correctedBuffer.setSize (1, blocksize, true, true, true);
+	arena.claim (correctedBuffer, 1, blocksize);
 	Base::prepare (samplerate);
 }
 
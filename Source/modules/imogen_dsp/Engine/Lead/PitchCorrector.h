@@ -12,7 +12,7 @@ public:
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 	using Base		  = dsp::psola::PitchCorrectorBase<SampleType>;
 
-	PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse);
+	PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse, AudioArena<SampleType>& arenaToUse);
 
 	void renderNextFrame (int numSamples);
 
@@ -20,9 +20,12 @@ public:
 
 	const AudioBuffer& getCorrectedSignal() const;
 
+	static constexpr int numArenaChannels = 1;
+
 private:
 
-	Internals& internals;
+	Internals&				internals;
+	AudioArena<SampleType>& arena;
 
 	AudioBuffer correctedBuffer;
 	AudioBuffer alias;
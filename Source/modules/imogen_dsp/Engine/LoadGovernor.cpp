@@ -0,0 +1,51 @@
+
+namespace Imogen
+{
+void LoadGovernor::reset() noexcept
+{
+	level			 = 0;
+	overloadedChunks = 0;
+	calmChunks		 = 0;
+}
+
+void LoadGovernor::update (double elapsedSeconds, double budgetSeconds) noexcept
+{
+	if (budgetSeconds <= 0.)
+		return;
+
+	const auto load = elapsedSeconds / budgetSeconds;
+
+	if (load > overloadRatio)
+	{
+		calmChunks = 0;
+
+		if (++overloadedChunks < overloadChunks)
+			return;
+
+		overloadedChunks = 0;
+
+		if (level < maxLevel)
+		{
+			++level;
+			++numDegradations;
+		}
+
+		return;
+	}
+
+	overloadedChunks = 0;
+
+	if (load > headroomRatio || level == 0)
+	{
+		calmChunks = 0;
+		return;
+	}
+
+	if (++calmChunks >= recoveryChunks)
+	{
+		--level;
+		calmChunks = 0;
+	}
+}
+
+}  // namespace Imogen
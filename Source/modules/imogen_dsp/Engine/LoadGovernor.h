@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	Watches how much of each chunk's real-time budget the engine uses, and steps the load shedding level up when
+	several chunks in a row come close to their deadline, so a single slow chunk (a page fault, a preempted thread) doesn't drop voices.
+	The level steps back down once there has been enough headroom for a while.
+*/
+class LoadGovernor
+{
+public:
+
+	void reset() noexcept;
+
+	void update (double elapsedSeconds, double budgetSeconds) noexcept;
+
+	int getLevel() const noexcept { return level; }
+
+	int getNumDegradations() const noexcept { return numDegradations; }
+
+	static constexpr int maxLevel = 8;
+
+private:
+
+	static constexpr double overloadRatio  = 0.8;
+	static constexpr double headroomRatio  = 0.5;
+	static constexpr int	overloadChunks = 3;
+	static constexpr int	recoveryChunks = 100;
+
+	int level { 0 };
+	int overloadedChunks { 0 };
+	int calmChunks { 0 };
+	int numDegradations { 0 };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,145 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+Metering<SampleType>::Metering()
+{
+	// Hann-windowed sinc, interpolating between the two middle samples of the history window
+	static constexpr auto halfWidth = numTaps / 2;
+
+	for (auto phase = 1; phase < oversampling; ++phase)
+	{
+		for (auto tap = 0; tap < numTaps; ++tap)
+		{
+			const auto distance = static_cast<double> (halfWidth - 1 - tap) + static_cast<double> (phase) / oversampling;
+			const auto x		= juce::MathConstants<double>::pi * distance;
+			const auto sinc		= x == 0. ? 1. : std::sin (x) / x;
+			const auto window	= 0.5 + 0.5 * std::cos (juce::MathConstants<double>::pi * distance / (halfWidth + 0.5));
+
+			coefficients[phase - 1][tap] = static_cast<float> (sinc * window);
+		}
+	}
+}
+
+template <typename SampleType>
+void Metering<SampleType>::prepare (double samplerate)
+{
+	rmsRate		= 1. / (rmsSeconds * samplerate);
+	releaseRate = peakReleaseDbPerSecond * std::log (10.) / (20. * samplerate);
+	holdSamples = juce::roundToInt (peakHoldSeconds * samplerate);
+
+	reset();
+}
+
+template <typename SampleType>
+void Metering<SampleType>::reset() noexcept
+{
+	for (auto& row : history)
+		std::fill (std::begin (row), std::end (row), 0.f);
+
+	position = 0;
+
+	for (auto& lane : held)
+		lane = {};
+}
+
+template <typename SampleType>
+void Metering<SampleType>::process (const SampleType* inputLeft, const SampleType* inputRight, const AudioBuffer& output, int numSamples,
+								   MeterReadings& readings) noexcept
+{
+	if (numSamples <= 0)
+		return;
+
+	const auto* left  = output.getReadPointer (0);
+	const auto* right = output.getReadPointer (std::min (1, output.getNumChannels() - 1));
+
+	alignas (32) float sumOfSquares[numLanes] {};
+	alignas (32) float peak[numLanes] {};
+	alignas (32) float truePeak[numLanes] {};
+
+	auto pos = position;
+
+	for (auto i = 0; i < numSamples; ++i)
+	{
+		const auto input = static_cast<float> ((inputLeft[i] + inputRight[i]) * SampleType (0.5));
+
+		const float samples[numLanes] { input, static_cast<float> (left[i]), static_cast<float> (right[i]), 0.f };
+
+		pos = pos == 0 ? numTaps - 1 : pos - 1;
+
+		for (auto lane = 0; lane < numLanes; ++lane)
+		{
+			const auto sample = samples[lane];
+
+			sumOfSquares[lane] += sample * sample;
+			peak[lane] = std::max (peak[lane], std::abs (sample));
+
+			history[pos][lane]			 = sample;
+			history[pos + numTaps][lane] = sample;
+		}
+
+		const auto* window = history + pos;
+
+		for (const auto& row : coefficients)
+		{
+			alignas (32) float interpolated[numLanes] {};
+
+			for (auto tap = 0; tap < numTaps; ++tap)
+				for (auto lane = 0; lane < numLanes; ++lane)
+					interpolated[lane] += row[tap] * window[numTaps - 1 - tap][lane];
+
+			for (auto lane = 0; lane < numLanes; ++lane)
+				truePeak[lane] = std::max (truePeak[lane], std::abs (interpolated[lane]));
+		}
+	}
+
+	position = pos;
+
+	const auto scale = 1.f / static_cast<float> (numSamples);
+
+	// how much of the integrated energy this chunk replaces, and how far a released peak falls over it
+	const auto rmsWeight = static_cast<float> (1. - std::exp (-rmsRate * numSamples));
+	const auto release	 = static_cast<float> (std::exp (-releaseRate * numSamples));
+
+	MeterReadings::Level* levels[] { &readings.input, &readings.outputL, &readings.outputR };
+
+	for (auto lane = 0; lane < 3; ++lane)
+	{
+		auto& h = held[lane];
+
+		h.energy += (sumOfSquares[lane] * scale - h.energy) * rmsWeight;
+		h.peak.update (peak[lane], numSamples, holdSamples, release);
+		h.truePeak.update (std::max (peak[lane], truePeak[lane]), numSamples, holdSamples, release);
+
+		auto& level = *levels[lane];
+
+		level.rms	   = std::sqrt (h.energy);
+		level.peak	   = h.peak.value;
+		level.truePeak = h.truePeak.value;
+	}
+}
+
+template <typename SampleType>
+void Metering<SampleType>::PeakHold::update (float newPeak, int numSamples, int holdSamples, float release) noexcept
+{
+	if (newPeak >= value)
+	{
+		value		= newPeak;
+		samplesLeft = holdSamples;
+		return;
+	}
+
+	if (samplesLeft > 0)
+	{
+		samplesLeft -= numSamples;
+		return;
+	}
+
+	value = std::max (newPeak, value * release);
+}
+
+
+template class Metering<float>;
+template class Metering<double>;
+
+}  // namespace Imogen
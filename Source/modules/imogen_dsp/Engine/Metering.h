@@ -0,0 +1,70 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	Measures RMS, peak and true peak for the input and both output channels in one pass over the chunk.
+	The three taps are carried as lanes of one four-wide array (the fourth is padding), so every step of the loop,
+	including the 4x oversampling interpolator behind the true peak, is a straight-line operation the compiler vectorises.
+	The readings aren't per chunk: peaks are held and then released, and the RMS is integrated over a window much longer
+	than a chunk, so a reader polling at any rate still sees every peak and the energy of the chunks it didn't look at.
+*/
+template <typename SampleType>
+class Metering
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	Metering();
+
+	void prepare (double samplerate);
+
+	void reset() noexcept;
+
+	/*
+		The input is metered as the average of inputLeft and inputRight, which can be the same channel, so it reads the
+		raw host input the way the engine takes it in. output is the final stereo output for the same chunk.
+	*/
+	void process (const SampleType* inputLeft, const SampleType* inputRight, const AudioBuffer& output, int numSamples, MeterReadings& readings) noexcept;
+
+private:
+
+	static constexpr int numLanes	  = 4;
+	static constexpr int oversampling = 4;
+	static constexpr int numTaps	  = 8;
+
+	// one row of taps for each in-between position; the on-sample position is just the sample itself
+	alignas (32) float coefficients[oversampling - 1][numTaps] {};
+
+	// every sample is written twice, numTaps apart, so the newest numTaps samples are always contiguous
+	alignas (32) float history[numTaps * 2][numLanes] {};
+
+	int position { 0 };
+
+	static constexpr auto rmsSeconds			 = 0.3;
+	static constexpr auto peakHoldSeconds		 = 0.5;
+	static constexpr auto peakReleaseDbPerSecond = 20.;
+
+	struct PeakHold
+	{
+		void update (float newPeak, int numSamples, int holdSamples, float release) noexcept;
+
+		float value { 0.f };
+		int	  samplesLeft { 0 };
+	};
+
+	struct Held
+	{
+		float	 energy { 0.f };
+		PeakHold peak, truePeak;
+	};
+
+	Held held[3];
+
+	// per sample, so they can be scaled to any chunk length
+	double rmsRate { 0. }, releaseRate { 0. };
+	int	   holdSamples { 0 };
+};
+
+}  // namespace Imogen
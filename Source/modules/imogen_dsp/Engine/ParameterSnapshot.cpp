@@ -0,0 +1,65 @@
+
+namespace Imogen
+{
+void ParameterSnapshot::capture (Parameters& parameters)
+{
+	auto& midi = parameters.midiState;
+
+	update (harmonyMidi,
+			HarmonyMidi { midi.midiLatch->get(), midi.voiceStealing->get(), midi.aftertouchToggle->get(),
+						  midi.pitchGlide->get(), midi.pedalToggle->get(), midi.descantToggle->get(),
+						  midi.velocitySens->get(), midi.pitchbendRange->get(), parameters.lowestPanned->get(),
+						  midi.pedalThresh->get(), midi.pedalInterval->get(), midi.descantThresh->get(), midi.descantInterval->get(),
+						  midi.glideTime->get() },
+			Group::harmonyMidi);
+
+	update (adsr,
+			Adsr { midi.adsrAttack->get(), midi.adsrDecay->get(),
+				   static_cast<float> (midi.adsrSustain->get()) * 0.01f, midi.adsrRelease->get() },
+			Group::adsr);
+
+	auto& eq = parameters.eqState;
+
+	update (lowShelf, EqBand { eq.eqLowShelfFreq->get(), eq.eqLowShelfQ->get(), eq.eqLowShelfGain->get() }, Group::eqLowShelf);
+	update (highShelf, EqBand { eq.eqHighShelfFreq->get(), eq.eqHighShelfQ->get(), eq.eqHighShelfGain->get() }, Group::eqHighShelf);
+	update (peak, EqBand { eq.eqPeakFreq->get(), eq.eqPeakQ->get(), eq.eqPeakGain->get() }, Group::eqPeak);
+	update (highPass, EqBand { eq.eqHighPassFreq->get(), eq.eqHighPassQ->get(), 0.f }, Group::eqHighPass);
+
+	update (compressorAmount, parameters.compAmount->get(), Group::compressor);
+
+	update (deEsser, DeEsser { parameters.deEsserThresh->get(), parameters.deEsserAmount->get() }, Group::deEsser);
+
+	auto& verb = parameters.reverbState;
+
+	update (reverb,
+			Reverb { verb.reverbDryWet->get(), verb.reverbDecay->get(), verb.reverbDuck->get(),
+					 verb.reverbLoCut->get(), verb.reverbHiCut->get() },
+			Group::reverb);
+
+	// the width has two consumers on what can be different threads, so each gets its own bit
+	if (const auto width = parameters.stereoWidth->get(); width != stereoWidth)
+	{
+		stereoWidth = width;
+		markDirty (Group::pannerWidth);
+		markDirty (Group::reverbWidth);
+	}
+}
+
+void ParameterSnapshot::markAllDirty() noexcept
+{
+	pending.store (~0u, std::memory_order_relaxed);
+}
+
+void ParameterSnapshot::markDirty (Group group) noexcept
+{
+	pending.fetch_or (static_cast<std::uint32_t> (group), std::memory_order_relaxed);
+}
+
+bool ParameterSnapshot::consume (Group group) noexcept
+{
+	const auto bit = static_cast<std::uint32_t> (group);
+
+	return (pending.fetch_and (~bit, std::memory_order_relaxed) & bit) != 0;
+}
+
+}  // namespace Imogen
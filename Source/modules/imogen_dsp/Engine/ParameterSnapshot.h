@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+
+#include <imogen_state/imogen_state.h>
+
+namespace Imogen
+{
+/*
+	Reads every parameter that feeds a DSP object's settings once at the top of each chunk.
+	Each group of values has a dirty bit, which stays set until the stage that owns the group consumes it,
+	so a stage that skips a chunk still picks up the changes it missed.
+	Values are only written by capture(), before the pipeline worker is started; the dirty bits are atomic because
+	the host thread and the worker consume their own groups at the same time.
+*/
+class ParameterSnapshot
+{
+public:
+
+	enum class Group : std::uint32_t
+	{
+		harmonyMidi = 1 << 0,
+		adsr		= 1 << 1,
+		pannerWidth = 1 << 2,
+		eqLowShelf	= 1 << 3,
+		eqHighShelf = 1 << 4,
+		eqPeak		= 1 << 5,
+		eqHighPass	= 1 << 6,
+		compressor	= 1 << 7,
+		deEsser		= 1 << 8,
+		reverb		= 1 << 9,
+		reverbWidth = 1 << 10
+	};
+
+	struct HarmonyMidi
+	{
+		bool latch {}, stealing {}, aftertouch {}, glide {}, pedal {}, descant {};
+		int	 velocitySens {}, pitchbendRange {}, lowestPanned {};
+		int	 pedalThresh {}, pedalInterval {}, descantThresh {}, descantInterval {};
+		float glideTime {};
+
+		bool operator== (const HarmonyMidi&) const = default;
+	};
+
+	struct Adsr
+	{
+		float attack {}, decay {}, sustain {}, release {};
+
+		bool operator== (const Adsr&) const = default;
+	};
+
+	struct EqBand
+	{
+		float freq {}, q {}, gain {};
+
+		bool operator== (const EqBand&) const = default;
+	};
+
+	struct DeEsser
+	{
+		float thresh {};
+		int	  amount {};
+
+		bool operator== (const DeEsser&) const = default;
+	};
+
+	struct Reverb
+	{
+		int	  dryWet {}, decay {}, duck {};
+		float loCut {}, hiCut {};
+
+		bool operator== (const Reverb&) const = default;
+	};
+
+	void capture (Parameters& parameters);
+
+	void markAllDirty() noexcept;
+
+	void markDirty (Group group) noexcept;
+
+	/* Returns true if the group has changed since it was last consumed. */
+	[[nodiscard]] bool consume (Group group) noexcept;
+
+	HarmonyMidi harmonyMidi;
+	Adsr		adsr;
+	EqBand		lowShelf, highShelf, peak, highPass;
+	int			compressorAmount { 0 };
+	DeEsser		deEsser;
+	Reverb		reverb;
+	int			stereoWidth { 0 };
+
+private:
+
+	template <typename Values>
+	void update (Values& current, const Values& latest, Group group) noexcept
+	{
+		if (current == latest)
+			return;
+
+		current = latest;
+		markDirty (group);
+	}
+
+	std::atomic<std::uint32_t> pending { ~0u };
+};
+
+}  // namespace Imogen
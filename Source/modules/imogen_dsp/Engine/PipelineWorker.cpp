@@ -0,0 +1,63 @@
+
+namespace Imogen
+{
+PipelineWorker::PipelineWorker (Client& clientToUse)
+	: client (clientToUse), thread ([this]
+									{ workerLoop(); })
+{
+}
+
+PipelineWorker::~PipelineWorker()
+{
+	shouldExit.store (true, std::memory_order_release);
+
+	generation.fetch_add (1, std::memory_order_release);
+	generation.notify_one();
+
+	thread.join();
+}
+
+void PipelineWorker::start() noexcept
+{
+	generation.fetch_add (1, std::memory_order_release);
+	generation.notify_one();
+}
+
+void PipelineWorker::waitForCompletion() noexcept
+{
+	const auto target = generation.load (std::memory_order_relaxed);
+
+	while (completed.load (std::memory_order_acquire) != target)
+		pauseWhileSpinning();
+}
+
+void PipelineWorker::workerLoop()
+{
+	promoteCurrentThreadToRealtime();
+
+	static constexpr auto spinIterations = 512;
+
+	auto seen = generation.load (std::memory_order_acquire);
+
+	while (true)
+	{
+		for (auto i = 0; i < spinIterations && generation.load (std::memory_order_acquire) == seen; ++i)
+			std::this_thread::yield();
+
+		generation.wait (seen, std::memory_order_acquire);
+		seen = generation.load (std::memory_order_acquire);
+
+		if (shouldExit.load (std::memory_order_acquire))
+			return;
+
+		{
+			const RealtimeScope realtimeScope;
+
+			client.runPipelineStage();
+		}
+
+		completed.store (seen, std::memory_order_release);
+	}
+}
+
+}  // namespace Imogen
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "Utils/RealtimeThread.h"
+#include "Utils/RealtimeSentinel.h"
+
+namespace Imogen
+{
+/*
+	One pre-spawned real-time thread that runs a single pipeline stage alongside the audio thread.
+	The audio thread kicks the stage off with start() and collects it with waitForCompletion();
+	neither call locks or allocates.
+*/
+class PipelineWorker
+{
+public:
+
+	struct Client
+	{
+		virtual ~Client() = default;
+
+		virtual void runPipelineStage() = 0;
+	};
+
+	explicit PipelineWorker (Client& clientToUse);
+
+	~PipelineWorker();
+
+	void start() noexcept;
+
+	void waitForCompletion() noexcept;
+
+private:
+
+	void workerLoop();
+
+	Client& client;
+
+	alignas (64) std::atomic<std::uint32_t> generation { 0 };
+	alignas (64) std::atomic<std::uint32_t> completed { 0 };
+
+	std::atomic<bool> shouldExit { false };
+
+	std::thread thread;
+};
+
+}  // namespace Imogen
@@ -0,0 +1,176 @@
+
+#if JUCE_WINDOWS
+#	include <malloc.h>
+#else
+#	include <sys/mman.h>
+#	include <unistd.h>
+#endif
+
+namespace Imogen
+{
+template <typename SampleType>
+AudioArena<SampleType>::~AudioArena()
+{
+	release();
+}
+
+template <typename SampleType>
+void AudioArena<SampleType>::prepare (int totalChannels, int blocksize, bool lockInMemory)
+{
+	static constexpr auto samplesPerLine = static_cast<int> (alignment / sizeof (SampleType));
+
+	const auto newStride = (blocksize + samplesPerLine - 1) / samplesPerLine * samplesPerLine;
+
+	const auto bytesNeeded = sizeof (SampleType) * static_cast<size_t> (totalChannels * newStride);
+
+	if (bytesNeeded > capacityBytes)
+		allocate (bytesNeeded);
+
+	// regions are remembered by channel index, so they only stay valid while every one of them still fits
+	const auto regionsFit = std::all_of (regions.begin(), regions.end(), [totalChannels] (const Region& region)
+										 { return region.firstChannel + region.numChannels <= totalChannels; });
+
+	if (! regionsFit)
+	{
+		regions.clear();
+		nextChannel = 0;
+	}
+
+	channelStride = newStride;
+
+	auto* samples = reinterpret_cast<SampleType*> (memory);
+
+	channels.resize (static_cast<size_t> (totalChannels));
+
+	for (auto chan = 0; chan < totalChannels; ++chan)
+		channels[static_cast<size_t> (chan)] = samples + chan * channelStride;
+
+	if (lockInMemory)
+		lock();
+	else
+		unlock();
+}
+
+template <typename SampleType>
+bool AudioArena<SampleType>::claim (AudioBuffer& buffer, int numChannels, int numSamples)
+{
+	jassert (numSamples <= channelStride);
+
+	for (const auto& region : regions)
+	{
+		if (region.owner == &buffer && region.numChannels == numChannels)
+		{
+			buffer.setDataToReferTo (channels.data() + region.firstChannel, numChannels, numSamples);
+			buffer.clear();
+			return true;
+		}
+	}
+
+	if (memory == nullptr || nextChannel + numChannels > static_cast<int> (channels.size()))
+	{
+		jassertfalse;
+		buffer = AudioBuffer();
+		return false;
+	}
+
+	regions.push_back ({ &buffer, nextChannel, numChannels });
+
+	buffer.setDataToReferTo (channels.data() + nextChannel, numChannels, numSamples);
+	buffer.clear();
+
+	nextChannel += numChannels;
+
+	return true;
+}
+
+template <typename SampleType>
+size_t AudioArena<SampleType>::getPageSize() noexcept
+{
+#if JUCE_WINDOWS
+	return 4096;
+#else
+	return static_cast<size_t> (sysconf (_SC_PAGESIZE));
+#endif
+}
+
+/* Page-aligned, so that madvise and mlock apply to exactly the arena. The stride keeps every channel cache-line aligned within it. */
+template <typename SampleType>
+void AudioArena<SampleType>::allocate (size_t bytes)
+{
+	release();
+
+	const auto pageSize = getPageSize();
+	const auto size		= (bytes + pageSize - 1) / pageSize * pageSize;
+
+#if JUCE_WINDOWS
+	memory = static_cast<std::byte*> (_aligned_malloc (size, pageSize));
+
+	if (memory != nullptr)
+		std::memset (memory, 0, size);
+#else
+	auto* mapped = mmap (nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	memory = mapped != MAP_FAILED ? static_cast<std::byte*> (mapped) : nullptr;
+
+#	ifdef MADV_HUGEPAGE
+	// transparent huge pages can be disabled system-wide, which costs nothing but some TLB misses
+	if (memory != nullptr && madvise (memory, size, MADV_HUGEPAGE) != 0)
+		DBG ("AudioArena: huge pages unavailable: " << std::strerror (errno));
+#	endif
+#endif
+
+	jassert (memory != nullptr);
+
+	capacityBytes = memory != nullptr ? size : 0;
+
+	// the old regions pointed into the old allocation, but their channel indices still apply to the new one
+}
+
+template <typename SampleType>
+void AudioArena<SampleType>::release()
+{
+	unlock();
+
+	if (memory == nullptr)
+		return;
+
+#if JUCE_WINDOWS
+	_aligned_free (memory);
+#else
+	munmap (memory, capacityBytes);
+#endif
+
+	memory		  = nullptr;
+	capacityBytes = 0;
+}
+
+template <typename SampleType>
+void AudioArena<SampleType>::lock()
+{
+#if ! JUCE_WINDOWS
+	if (isLocked || memory == nullptr)
+		return;
+
+	// locking can fail without the right permissions, in which case the arena is just left pageable
+	isLocked = mlock (memory, capacityBytes) == 0;
+
+	if (! isLocked)
+		DBG ("AudioArena: couldn't lock the arena in memory: " << std::strerror (errno));
+#endif
+}
+
+template <typename SampleType>
+void AudioArena<SampleType>::unlock()
+{
+#if ! JUCE_WINDOWS
+	if (isLocked)
+		munlock (memory, capacityBytes);
+#endif
+
+	isLocked = false;
+}
+
+template class AudioArena<float>;
+template class AudioArena<double>;
+
+}  // namespace Imogen
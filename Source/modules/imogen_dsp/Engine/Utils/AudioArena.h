@@ -0,0 +1,59 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	One page-aligned allocation that the engine's stages take their audio buffers from, so the block's working set is contiguous
+	and can be locked into memory. Each buffer passed to claim() is pointed at its own region, and keeps that region across prepares
+	for as long as the layout still fits, so re-preparing hands every stage back the channels it had before.
+*/
+template <typename SampleType>
+class AudioArena
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	~AudioArena();
+
+	/* Only reallocates if the new layout doesn't fit in the current allocation. */
+	void prepare (int totalChannels, int blocksize, bool lockInMemory);
+
+	/*
+		Points the buffer at its region of the arena. Asking for more channels than were passed to prepare() is a bug in the engine's budget:
+		it asserts, leaves the buffer empty and returns false, and never falls back to allocating.
+	*/
+	bool claim (AudioBuffer& buffer, int numChannels, int numSamples);
+
+	size_t getSizeInBytes() const noexcept { return capacityBytes; }
+
+	static constexpr size_t alignment = 64;
+
+private:
+
+	struct Region
+	{
+		const AudioBuffer* owner;
+		int				   firstChannel, numChannels;
+	};
+
+	static size_t getPageSize() noexcept;
+
+	void allocate (size_t bytes);
+	void release();
+
+	void lock();
+	void unlock();
+
+	std::byte* memory { nullptr };
+
+	std::vector<SampleType*> channels;
+	std::vector<Region>		 regions;
+
+	size_t capacityBytes { 0 };
+	int	   channelStride { 0 };
+	int	   nextChannel { 0 };
+	bool   isLocked { false };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <type_traits>
+
+namespace Imogen
+{
+/*
+	While a parameter is moving, its new value is applied at this interval instead of once per block.
+	The host's parameter changes aren't timestamped, so a move is only known from one block's value to the next.
+	Only stages whose Lemons object applies a new value at once are sliced; ones that smooth their own changes, like SmoothedGain, aren't.
+*/
+static constexpr int automationSliceSize = 32;
+
+/*
+	Calls callback (startSample, numSamples, value) once for the whole block if the value hasn't moved since the last block.
+	Otherwise the block is split into slices, and the value steps linearly from start to end, reaching end on the last slice.
+*/
+template <typename ValueType, typename Callback>
+void forEachAutomationSlice (ValueType start, std::type_identity_t<ValueType> end, int numSamples, Callback&& callback)
+{
+	if (start == end || numSamples <= automationSliceSize)
+	{
+		callback (0, numSamples, end);
+		return;
+	}
+
+	for (auto startSample = 0; startSample < numSamples; startSample += automationSliceSize)
+	{
+		const auto length	  = std::min (automationSliceSize, numSamples - startSample);
+		const auto proportion = static_cast<double> (startSample + length) / static_cast<double> (numSamples);
+		const auto exact	  = static_cast<double> (start) + static_cast<double> (end - start) * proportion;
+
+		if constexpr (std::is_integral_v<ValueType>)
+			callback (startSample, length, static_cast<ValueType> (juce::roundToInt (exact)));
+		else
+			callback (startSample, length, static_cast<ValueType> (exact));
+	}
+}
+
+/* A view of part of a buffer, without copying or allocating. */
+template <typename SampleType>
+juce::AudioBuffer<SampleType> sliceOf (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples)
+{
+	return { const_cast<SampleType* const*> (buffer.getArrayOfReadPointers()), buffer.getNumChannels(), startSample, numSamples };
+}
+
+}  // namespace Imogen
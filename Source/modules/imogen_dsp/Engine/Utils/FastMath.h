@@ -0,0 +1,73 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace Imogen
+{
+/*
+	Branch-free log2 / exp2 approximations built from plain arithmetic and bit casts,
+	so loops calling them per sample can still be vectorised. Both stay within about 2e-5 of the exact result
+	(well under 0.001 dB when used for gain curves).
+*/
+template <typename SampleType>
+struct FloatBits
+{
+	static_assert (std::is_same_v<SampleType, float> || std::is_same_v<SampleType, double>);
+
+	static constexpr auto isFloat = std::is_same_v<SampleType, float>;
+
+	using Int = std::conditional_t<isFloat, std::int32_t, std::int64_t>;
+
+	static constexpr int mantissaBits = isFloat ? 23 : 52;
+	static constexpr Int bias		  = isFloat ? 127 : 1023;
+	static constexpr Int mantissaMask = (Int (1) << mantissaBits) - 1;
+	static constexpr Int exponentOf1  = bias << mantissaBits;
+};
+
+/* x must be positive and normal. */
+template <typename SampleType>
+inline SampleType fastLog2 (SampleType x) noexcept
+{
+	using Bits = FloatBits<SampleType>;
+
+	const auto bits		= std::bit_cast<typename Bits::Int> (x);
+	const auto exponent = static_cast<SampleType> ((bits >> Bits::mantissaBits) - Bits::bias);
+	const auto mantissa = std::bit_cast<SampleType> ((bits & Bits::mantissaMask) | Bits::exponentOf1);
+
+	// log2 (m) = 2/ln2 * atanh ((m - 1) / (m + 1)), and the argument stays below 1/3 for m in [1, 2)
+	const auto t  = (mantissa - SampleType (1)) / (mantissa + SampleType (1));
+	const auto t2 = t * t;
+
+	constexpr auto c1 = SampleType (2.8853900817779268);  // 2 / ln2
+	constexpr auto c3 = c1 / SampleType (3);
+	constexpr auto c5 = c1 / SampleType (5);
+	constexpr auto c7 = c1 / SampleType (7);
+
+	return exponent + t * (c1 + t2 * (c3 + t2 * (c5 + t2 * c7)));
+}
+
+/* Accurate for results inside the normal range of SampleType; y is clamped to keep it there. */
+template <typename SampleType>
+inline SampleType fastExp2 (SampleType y) noexcept
+{
+	using Bits = FloatBits<SampleType>;
+	using Int  = typename Bits::Int;
+
+	constexpr auto limit = static_cast<SampleType> (Bits::bias - 1);
+
+	y = std::min (std::max (y, -limit), limit);
+
+	auto whole = static_cast<Int> (y);
+	whole -= static_cast<SampleType> (whole) > y ? 1 : 0;
+
+	// 2^f = e^(f ln2), Taylor series to the sixth power for f in [0, 1)
+	const auto f = (y - static_cast<SampleType> (whole)) * SampleType (0.69314718055994531);
+
+	const auto fraction = SampleType (1) + f * (SampleType (1) + f * (SampleType (1) / 2 + f * (SampleType (1) / 6 + f * (SampleType (1) / 24 + f * (SampleType (1) / 120 + f * (SampleType (1) / 720))))));
+
+	return std::bit_cast<SampleType> (std::bit_cast<Int> (fraction) + (whole << Bits::mantissaBits));
+}
+
+}  // namespace Imogen
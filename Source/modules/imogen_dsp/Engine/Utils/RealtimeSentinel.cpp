@@ -0,0 +1,302 @@
+
+#if IMOGEN_RT_SENTINEL && ! JUCE_WINDOWS
+#	include <dlfcn.h>
+#	include <pthread.h>
+#	include <time.h>
+#endif
+
+#if IMOGEN_RT_SENTINEL && JUCE_LINUX
+#	include <cstdarg>
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#endif
+
+namespace Imogen
+{
+#if IMOGEN_RT_SENTINEL
+
+static thread_local bool realtimeScopeActive = false;
+
+static std::atomic<int> numViolations { 0 };
+
+RealtimeScope::RealtimeScope() noexcept
+	: wasActive (realtimeScopeActive)
+{
+	realtimeScopeActive = true;
+}
+
+RealtimeScope::~RealtimeScope()
+{
+	realtimeScopeActive = wasActive;
+}
+
+bool RealtimeScope::isActive() noexcept
+{
+	return realtimeScopeActive;
+}
+
+void RealtimeScope::reportViolation (const char* what)
+{
+	// building the report allocates, so the checks are off until it's written
+	realtimeScopeActive = false;
+
+	numViolations.fetch_add (1, std::memory_order_relaxed);
+
+	juce::Logger::outputDebugString (juce::String ("Real-time violation: ") + what + juce::newLine
+									 + juce::SystemStats::getStackBacktrace());
+
+	realtimeScopeActive = true;
+
+	jassertfalse;
+}
+
+int RealtimeScope::getNumViolations() noexcept
+{
+	return numViolations.load (std::memory_order_relaxed);
+}
+
+#else
+
+RealtimeScope::RealtimeScope() noexcept
+	: wasActive (false)
+{
+}
+
+RealtimeScope::~RealtimeScope() = default;
+
+bool RealtimeScope::isActive() noexcept
+{
+	return false;
+}
+
+void RealtimeScope::reportViolation (const char*)
+{
+}
+
+int RealtimeScope::getNumViolations() noexcept
+{
+	return 0;
+}
+
+#endif
+
+}  // namespace Imogen
+
+
+#if IMOGEN_RT_SENTINEL
+
+void* operator new (std::size_t size)
+{
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("heap allocation");
+
+	if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+	return operator new (size);
+}
+
+void operator delete (void* ptr) noexcept
+{
+	if (ptr != nullptr && Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("heap deallocation");
+
+	std::free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+	operator delete (ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+	operator delete (ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t) noexcept
+{
+	operator delete (ptr);
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("aligned heap allocation");
+
+	const auto align = static_cast<std::size_t> (alignment);
+
+#	if JUCE_WINDOWS
+	if (auto* ptr = _aligned_malloc (size == 0 ? 1 : size, align))
+		return ptr;
+#	else
+	// aligned_alloc wants the size to be a multiple of the alignment
+	if (auto* ptr = std::aligned_alloc (align, (std::max (size, std::size_t (1)) + align - 1) / align * align))
+		return ptr;
+#	endif
+
+	throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+	return operator new (size, alignment);
+}
+
+void operator delete (void* ptr, std::align_val_t) noexcept
+{
+	if (ptr != nullptr && Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("aligned heap deallocation");
+
+#	if JUCE_WINDOWS
+	_aligned_free (ptr);
+#	else
+	std::free (ptr);
+#	endif
+}
+
+void operator delete[] (void* ptr, std::align_val_t alignment) noexcept
+{
+	operator delete (ptr, alignment);
+}
+
+void operator delete (void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete (ptr, alignment);
+}
+
+void operator delete[] (void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete (ptr, alignment);
+}
+
+#	if ! JUCE_WINDOWS
+
+// these are found before libc's versions, and forward to them once the call has been checked
+
+template <typename Function>
+static Function findNextSymbol (const char* name)
+{
+	return reinterpret_cast<Function> (dlsym (RTLD_NEXT, name));
+}
+
+extern "C" int pthread_mutex_lock (pthread_mutex_t* mutex)
+{
+	using Function			   = int (*) (pthread_mutex_t*);
+	static const auto original = findNextSymbol<Function> ("pthread_mutex_lock");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("mutex lock");
+
+	return original (mutex);
+}
+
+// even an uncontended try-lock means the audio thread is sharing a lock with something that can hold it
+extern "C" int pthread_mutex_trylock (pthread_mutex_t* mutex) noexcept
+{
+	using Function			   = int (*) (pthread_mutex_t*);
+	static const auto original = findNextSymbol<Function> ("pthread_mutex_trylock");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("mutex try-lock");
+
+	return original (mutex);
+}
+
+extern "C" int pthread_cond_wait (pthread_cond_t* condition, pthread_mutex_t* mutex)
+{
+	using Function			   = int (*) (pthread_cond_t*, pthread_mutex_t*);
+	static const auto original = findNextSymbol<Function> ("pthread_cond_wait");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("condition variable wait");
+
+	return original (condition, mutex);
+}
+
+extern "C" int pthread_cond_timedwait (pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* timeout)
+{
+	using Function			   = int (*) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*);
+	static const auto original = findNextSymbol<Function> ("pthread_cond_timedwait");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("timed condition variable wait");
+
+	return original (condition, mutex, timeout);
+}
+
+#		if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 30)
+
+// what std::condition_variable::wait_for uses with a steady clock
+extern "C" int pthread_cond_clockwait (pthread_cond_t* condition, pthread_mutex_t* mutex, clockid_t clock, const struct timespec* timeout)
+{
+	using Function			   = int (*) (pthread_cond_t*, pthread_mutex_t*, clockid_t, const struct timespec*);
+	static const auto original = findNextSymbol<Function> ("pthread_cond_clockwait");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("timed condition variable wait");
+
+	return original (condition, mutex, clock, timeout);
+}
+
+#		endif
+
+extern "C" int nanosleep (const struct timespec* duration, struct timespec* remaining)
+{
+	using Function			   = int (*) (const struct timespec*, struct timespec*);
+	static const auto original = findNextSymbol<Function> ("nanosleep");
+
+	if (Imogen::RealtimeScope::isActive())
+		Imogen::RealtimeScope::reportViolation ("sleep");
+
+	return original (duration, remaining);
+}
+
+#	endif
+
+#	if JUCE_LINUX
+
+// std::atomic::wait and other hand-rolled locks block in the futex syscall without going through pthreads.
+// Only the waiting operations are reported: waking another thread never blocks the caller.
+extern "C" long syscall (long number, ...) noexcept
+{
+	using Function			   = long (*) (long, ...);
+	static const auto original = findNextSymbol<Function> ("syscall");
+
+	va_list args;
+	va_start (args, number);
+
+	long arguments[6];
+
+	for (auto& argument : arguments)
+		argument = va_arg (args, long);
+
+	va_end (args);
+
+	if (number == SYS_futex && Imogen::RealtimeScope::isActive())
+	{
+		switch (static_cast<int> (arguments[1]) & FUTEX_CMD_MASK)
+		{
+			case FUTEX_WAIT :
+			case FUTEX_WAIT_BITSET :
+			case FUTEX_LOCK_PI :
+			case FUTEX_WAIT_REQUEUE_PI :
+				Imogen::RealtimeScope::reportViolation ("futex wait");
+				break;
+
+			default :
+				break;
+		}
+	}
+
+	return original (number, arguments[0], arguments[1], arguments[2], arguments[3], arguments[4], arguments[5]);
+}
+
+#	endif
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+
+namespace Imogen
+{
+/*
+	While a RealtimeScope is alive on a thread, heap allocation (aligned or not), mutex locking and try-locking, condition variable
+	waits, sleeping and, on Linux, futex waits such as std::atomic::wait on that thread are reported with a stack trace.
+	The checks are only compiled in when IMOGEN_RT_SENTINEL is enabled; otherwise the scope does nothing.
+*/
+class RealtimeScope
+{
+public:
+
+	RealtimeScope() noexcept;
+
+	~RealtimeScope();
+
+	RealtimeScope (const RealtimeScope&) = delete;
+	RealtimeScope& operator= (const RealtimeScope&) = delete;
+
+	static bool isActive() noexcept;
+
+	static void reportViolation (const char* what);
+
+	static int getNumViolations() noexcept;
+
+private:
+
+	bool wasActive;
+};
+
+}  // namespace Imogen
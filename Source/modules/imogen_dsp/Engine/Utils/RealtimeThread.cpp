@@ -0,0 +1,19 @@
+
+#if ! JUCE_WINDOWS
+#	include <pthread.h>
+#endif
+
+namespace Imogen
+{
+void promoteCurrentThreadToRealtime()
+{
+#if ! JUCE_WINDOWS
+	sched_param param;
+	param.sched_priority = sched_get_priority_max (SCHED_FIFO) - 1;
+
+	// this can fail without the right permissions, in which case the thread keeps its default priority
+	pthread_setschedparam (pthread_self(), SCHED_FIFO, &param);
+#endif
+}
+
+}  // namespace Imogen
@@ -0,0 +1,22 @@
+#pragma once
+
+#if JUCE_INTEL
+#	include <immintrin.h>
+#endif
+
+namespace Imogen
+{
+/* Asks the OS to schedule the calling thread like an audio thread. Failing to get the priority isn't an error. */
+void promoteCurrentThreadToRealtime();
+
+/* A CPU hint for the body of a spin-wait, so spinning doesn't starve the sibling hyperthread or flood the memory bus. */
+inline void pauseWhileSpinning() noexcept
+{
+#if JUCE_INTEL
+	_mm_pause();
+#elif JUCE_ARM && ! JUCE_MSVC
+	__asm__ __volatile__ ("yield");
+#endif
+}
+
+}  // namespace Imogen
@@ -2,28 +2,26 @@
 namespace Imogen
 {
 template <typename SampleType>
-Compressor<SampleType>::Compressor (State& stateToUse)
-	: state (stateToUse)
+Compressor<SampleType>::Compressor (State& stateToUse, ParameterSnapshot& snapshotToUse)
+	: state (stateToUse), snapshot (snapshotToUse)
 {
-	//    static constexpr auto compressorAttackMs  = 4.0f;
-	//    static constexpr auto compressorReleaseMs = 200.0f;
+	dynamics.setTimes (attackMs, releaseMs);
 }
 
 template <typename SampleType>
-void Compressor<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void Compressor<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet)
 {
 	if (parameters.compToggle->get())
 	{
-		updateCompressorAmount (parameters.compAmount->get());
+		if (snapshot.consume (ParameterSnapshot::Group::compressor))
+			updateCompressorAmount (snapshot.compressorAmount);
 
-		dryComp.process (dry);
-		wetComp.process (wet);
-
-		meters.compRedux->set (static_cast<float> (dryComp.getAverageGainReduction() + wetComp.getAverageGainReduction()) * 0.5f);
+		meters.readings.compRedux = dynamics.process (dry, wet, processDry, processWet);
 	}
 	else
 	{
-		meters.compRedux->set (0.f);
+		// switched off counts as skipping both paths, so they start clean when it's switched back on
+		meters.readings.compRedux = dynamics.process (dry, wet, false, false);
 	}
 }
 
@@ -35,18 +33,15 @@ void Compressor<SampleType>::updateCompressorAmount (int amount)
 	const auto thresh = juce::jmap (a, 0.f, -60.f);
 	const auto ratio  = juce::jmap (a, 1.f, 10.f);
 
-	dryComp.setThreshold (thresh);
-	dryComp.setRatio (ratio);
-
-	wetComp.setThreshold (thresh);
-	wetComp.setRatio (ratio);
+	dynamics.setThreshold (thresh);
+	dynamics.setRatio (ratio);
 }
 
 template <typename SampleType>
-void Compressor<SampleType>::prepare (double samplerate, int blocksize)
+void Compressor<SampleType>::prepare (double samplerate, int)
 {
-	dryComp.prepare (samplerate, blocksize);
-	wetComp.prepare (samplerate, blocksize);
+	dynamics.prepare (samplerate);
+	updateCompressorAmount (parameters.compAmount->get());
 }
 
 template struct Compressor<float>;
@@ -7,9 +7,9 @@ struct Compressor
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	Compressor (State& stateToUse);
+	Compressor (State& stateToUse, ParameterSnapshot& snapshotToUse);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -21,7 +21,12 @@ private:
 	Parameters& parameters { state.parameters };
 	Meters&		meters { state.meters };
 
-	dsp::FX::Compressor<SampleType> dryComp, wetComp;
+	ParameterSnapshot& snapshot;
+
+	static constexpr auto attackMs	= 4.;
+	static constexpr auto releaseMs = 200.;
+
+	Dynamics<SampleType> dynamics;
 };
 
 }  // namespace Imogen
@@ -0,0 +1,410 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+ConvolutionReverb<SampleType>::ConvolutionReverb (const ImpulseResponse& impulseToUse)
+	: impulse (impulseToUse)
+{
+}
+
+template <typename SampleType>
+ConvolutionReverb<SampleType>::~ConvolutionReverb()
+{
+	stopWorker();
+
+	delete active;
+	delete pending.exchange (nullptr);
+	delete retired.exchange (nullptr);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::prepare (double newSamplerate, int newBlocksize)
+{
+	jassert (newSamplerate > 0. && newBlocksize > 0);
+
+	stopWorker();
+
+	samplerate = newSamplerate;
+	blocksize  = newBlocksize;
+
+	delete active;
+	delete pending.exchange (nullptr);
+	delete retired.exchange (nullptr);
+
+	active = buildKernel (loadedVersion).release();
+
+	requestedVersion = loadedVersion;
+
+	const auto tailSize = static_cast<size_t> (numChannels * tailPartitionSize);
+
+	for (auto& slot : slots)
+	{
+		slot.input.assign (tailSize, 0.f);
+		slot.output.assign (tailSize, 0.f);
+		slot.kernel = nullptr;
+		slot.outputBlock.store (~std::uint32_t (0), std::memory_order_relaxed);
+	}
+
+	dry.assign (static_cast<size_t> (numChannels * blocksize), 0.f);
+	wet.assign (static_cast<size_t> (numChannels * blocksize), 0.f);
+	tailInput.assign (tailSize, 0.f);
+	tailPlayback.assign (tailSize, 0.f);
+
+	tailPosition = 0;
+	blocksSent	 = 0;
+	nextBlock	 = 0;
+
+	sentBlocks.store (0, std::memory_order_relaxed);
+	wakeups.store (0, std::memory_order_relaxed);
+	retiredAfterBlock.store (0, std::memory_order_relaxed);
+
+	mixer.prepare (samplerate);
+
+	startWorker();
+}
+
+template <typename SampleType>
+std::unique_ptr<typename ConvolutionReverb<SampleType>::Kernel> ConvolutionReverb<SampleType>::buildKernel (int& version) const
+{
+	auto kernel = std::make_unique<Kernel>();
+
+	version = impulse.getVersion();
+
+	juce::AudioBuffer<float> source;
+	double					 sourceSamplerate;
+
+	if (! impulse.read (source, sourceSamplerate))
+		return kernel;
+
+	// resample to the engine's rate
+	if (std::abs (sourceSamplerate - samplerate) > 0.5)
+	{
+		const auto ratio	 = sourceSamplerate / samplerate;
+		const auto numOutput = static_cast<int> (std::ceil (source.getNumSamples() / ratio));
+
+		juce::AudioBuffer<float> resampled { source.getNumChannels(), numOutput };
+
+		for (auto chan = 0; chan < source.getNumChannels(); ++chan)
+		{
+			juce::LagrangeInterpolator interpolator;
+			interpolator.process (ratio, source.getReadPointer (chan), resampled.getWritePointer (chan), numOutput,
+								  source.getNumSamples(), 0);
+		}
+
+		source = std::move (resampled);
+	}
+
+	// scaled to unit energy in the loudest channel, so switching impulses doesn't jump wildly in level
+	auto maxEnergy = 0.f;
+
+	for (auto chan = 0; chan < source.getNumChannels(); ++chan)
+	{
+		const auto* data = source.getReadPointer (chan);
+
+		maxEnergy = std::max (maxEnergy, std::inner_product (data, data + source.getNumSamples(), data, 0.f));
+	}
+
+	if (maxEnergy <= 0.f)
+		return kernel;
+
+	source.applyGain (1.f / std::sqrt (maxEnergy));
+
+	const auto length = source.getNumSamples();
+
+	kernel->length = length;
+
+	for (auto chan = 0; chan < numChannels; ++chan)
+	{
+		const auto* data = source.getReadPointer (std::min (chan, source.getNumChannels() - 1));
+
+		kernel->head.push_back (std::make_unique<PartitionedConvolver> (headPartitionSize, data, std::min (length, headLength)));
+
+		if (length > headLength)
+			kernel->tail.push_back (std::make_unique<PartitionedConvolver> (tailPartitionSize, data + headLength, length - headLength));
+	}
+
+	return kernel;
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::startWorker()
+{
+	shouldExit.store (false, std::memory_order_release);
+
+	worker = std::thread ([this]
+						  { workerLoop(); });
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::stopWorker()
+{
+	if (! worker.joinable())
+		return;
+
+	shouldExit.store (true, std::memory_order_release);
+
+	wakeWorker();
+
+	worker.join();
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::workerLoop()
+{
+	auto wakeup = wakeups.load (std::memory_order_acquire);
+
+	while (true)
+	{
+		wakeups.wait (wakeup, std::memory_order_acquire);
+		wakeup = wakeups.load (std::memory_order_acquire);
+
+		if (shouldExit.load (std::memory_order_acquire))
+			return;
+
+		const auto seen = sentBlocks.load (std::memory_order_acquire);
+
+		updateKernels();
+
+		// far enough behind that the audio thread may be refilling the slots we haven't read yet:
+		// skip to the newest block and let the audio thread count the ones we dropped as misses
+		if (seen - nextBlock >= static_cast<std::uint32_t> (numSlots))
+		{
+			nextBlock = seen - 1;
+
+			if (auto* kernel = slots[nextBlock % numSlots].kernel)
+				for (auto& convolver : kernel->tail)
+					convolver->reset();
+		}
+
+		for (; nextBlock != seen; ++nextBlock)
+			processTailBlock (nextBlock);
+	}
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::updateKernels()
+{
+	// every block handed over before the swap has been processed, so nothing refers to the retired kernel any more
+	if (auto* old = retired.load (std::memory_order_acquire))
+	{
+		if (nextBlock >= retiredAfterBlock.load (std::memory_order_acquire))
+		{
+			retired.store (nullptr, std::memory_order_release);
+			delete old;
+		}
+	}
+
+	if (impulse.getVersion() == loadedVersion)
+		return;
+
+	auto kernel = buildKernel (loadedVersion);
+
+	// a kernel still pending was never seen by the audio thread, so it can go straight away
+	delete pending.exchange (kernel.release(), std::memory_order_acq_rel);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::processTailBlock (std::uint32_t block) noexcept
+{
+	auto& slot = slots[block % numSlots];
+
+	if (slot.kernel != nullptr && ! slot.kernel->tail.empty())
+	{
+		for (auto chan = 0; chan < numChannels; ++chan)
+		{
+			const auto offset = static_cast<size_t> (chan * tailPartitionSize);
+
+			slot.kernel->tail[static_cast<size_t> (chan)]->process (slot.input.data() + offset, slot.output.data() + offset, tailPartitionSize);
+		}
+	}
+	else
+	{
+		std::fill (slot.output.begin(), slot.output.end(), 0.f);
+	}
+
+	slot.outputBlock.store (block, std::memory_order_release);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::swapInPendingKernel() noexcept
+{
+	// only one kernel can wait to be freed at a time; a newer one stays pending until the worker has caught up
+	if (retired.load (std::memory_order_acquire) != nullptr)
+		return;
+
+	auto* newKernel = pending.exchange (nullptr, std::memory_order_acq_rel);
+
+	if (newKernel == nullptr)
+		return;
+
+	retiredAfterBlock.store (blocksSent, std::memory_order_relaxed);
+	retired.store (active, std::memory_order_release);
+
+	active = newKernel;
+
+	tailPosition = 0;
+	std::fill (tailInput.begin(), tailInput.end(), 0.f);
+	std::fill (tailPlayback.begin(), tailPlayback.end(), 0.f);
+
+	// a kernel without a tail never hands off a block, so the worker is told directly that it can free the old one
+	wakeWorker();
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::handOffTailBlock() noexcept
+{
+	const auto block = blocksSent++;
+
+	auto& slot = slots[block % numSlots];
+
+	std::copy (tailInput.begin(), tailInput.end(), slot.input.begin());
+	slot.kernel = active;
+
+	sentBlocks.store (blocksSent, std::memory_order_release);
+	wakeWorker();
+
+	// the previous block's tail is due from now on
+	if (block == 0)
+		return;
+
+	const auto& previous = slots[(block - 1) % numSlots];
+
+	if (previous.outputBlock.load (std::memory_order_acquire) == block - 1)
+	{
+		std::copy (previous.output.begin(), previous.output.end(), tailPlayback.begin());
+	}
+	else
+	{
+		std::fill (tailPlayback.begin(), tailPlayback.end(), 0.f);
+		++missedDeadlines;
+	}
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::wakeWorker() noexcept
+{
+	wakeups.fetch_add (1, std::memory_order_release);
+	wakeups.notify_one();
+}
+
+template <typename SampleType>
+bool ConvolutionReverb<SampleType>::process (AudioBuffer& audio, SampleType* level)
+{
+	// checked before anything else, because with no kernel or one without a tail nothing else would wake the worker
+	if (const auto version = impulse.getVersion(); version != requestedVersion)
+	{
+		requestedVersion = version;
+		wakeWorker();
+	}
+
+	swapInPendingKernel();
+
+	if (active == nullptr || active->head.empty())
+		return false;
+
+	const auto numSamples = audio.getNumSamples();
+
+	jassert (numSamples <= blocksize && audio.getNumChannels() > 0);
+
+	for (auto chan = 0; chan < numChannels; ++chan)
+	{
+		const auto* input = audio.getReadPointer (std::min (chan, audio.getNumChannels() - 1));
+		auto*		d	  = dry.data() + chan * blocksize;
+
+		for (auto i = 0; i < numSamples; ++i)
+			d[i] = static_cast<float> (input[i]);
+
+		active->head[static_cast<size_t> (chan)]->process (d, wet.data() + chan * blocksize, numSamples);
+	}
+
+	if (! active->tail.empty())
+	{
+		for (auto done = 0; done < numSamples;)
+		{
+			const auto count = std::min (numSamples - done, tailPartitionSize - tailPosition);
+
+			for (auto chan = 0; chan < numChannels; ++chan)
+			{
+				const auto* d = dry.data() + chan * blocksize + done;
+				auto*		w = wet.data() + chan * blocksize + done;
+
+				const auto tailOffset = chan * tailPartitionSize + tailPosition;
+
+				std::copy (d, d + count, tailInput.begin() + tailOffset);
+
+				for (auto i = 0; i < count; ++i)
+					w[i] += tailPlayback[static_cast<size_t> (tailOffset + i)];
+			}
+
+			done += count;
+			tailPosition += count;
+
+			if (tailPosition == tailPartitionSize)
+			{
+				handOffTailBlock();
+				tailPosition = 0;
+			}
+		}
+	}
+
+	mixer.process (audio, dry.data(), dry.data() + blocksize, wet.data(), wet.data() + blocksize, numSamples, level);
+
+	return true;
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::reset() noexcept
+{
+	if (active != nullptr)
+		for (auto& convolver : active->head)
+			convolver->reset();
+
+	tailPosition = 0;
+	std::fill (tailInput.begin(), tailInput.end(), 0.f);
+	std::fill (tailPlayback.begin(), tailPlayback.end(), 0.f);
+}
+
+template <typename SampleType>
+int ConvolutionReverb<SampleType>::getTailLength() const noexcept
+{
+	if (active == nullptr || active->head.empty())
+		return 0;
+
+	// a tail input block is only handed off once it's full, and its output is due one block after that
+	return active->length + (active->tail.empty() ? 0 : tailPartitionSize * 2);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::setDryWet (int percent) noexcept
+{
+	mixer.setDryWet (percent);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::setDuckAmount (int percent) noexcept
+{
+	mixer.setDuckAmount (percent);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::setLoCutFrequency (float frequency) noexcept
+{
+	mixer.setLoCutFrequency (frequency);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::setHiCutFrequency (float frequency) noexcept
+{
+	mixer.setHiCutFrequency (frequency);
+}
+
+template <typename SampleType>
+void ConvolutionReverb<SampleType>::setWidth (float newWidth) noexcept
+{
+	mixer.setWidth (newWidth);
+}
+
+template class ConvolutionReverb<float>;
+template class ConvolutionReverb<double>;
+
+}  // namespace Imogen
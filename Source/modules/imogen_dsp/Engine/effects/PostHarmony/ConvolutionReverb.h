@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "PartitionedConvolver.h"
+#include "ReverbMixer.h"
+
+namespace Imogen
+{
+/*
+	Impulse response reverb with non-uniform partitions.
+	The first headLength samples of the impulse are convolved on the audio thread in small partitions, with no added latency.
+	The rest is convolved on a background thread in large partitions: each completed tail input block is handed over
+	through a ring of slots, and its output isn't due until one full tail block later. If the worker ever misses that
+	deadline, the audio thread plays that block's tail as silence instead of waiting for it.
+	The same thread transforms new impulse responses from the state before handing them to the audio thread. The audio thread
+	wakes it when it sees the state's version change, so a new impulse is picked up whether or not the current kernel has a tail.
+*/
+template <typename SampleType>
+class ConvolutionReverb
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	explicit ConvolutionReverb (const ImpulseResponse& impulseToUse);
+
+	~ConvolutionReverb();
+
+	void prepare (double samplerate, int blocksize);
+
+	void setDryWet (int percent) noexcept;
+	void setDuckAmount (int percent) noexcept;
+	void setLoCutFrequency (float frequency) noexcept;
+	void setHiCutFrequency (float frequency) noexcept;
+	void setWidth (float newWidth) noexcept;
+
+	/* Mixes the reverb into audio in place. Returns false without touching audio while there's no impulse response loaded. */
+	[[nodiscard]] bool process (AudioBuffer& audio, SampleType* level);
+
+	/* Clears what the audio thread holds of the tail; whatever the worker still holds drains within one impulse length. */
+	void reset() noexcept;
+
+	/* How long after its input goes silent the reverb can still produce sound: the impulse, plus the tail's block of latency. */
+	int getTailLength() const noexcept;
+
+	int getNumMissedDeadlines() const noexcept { return missedDeadlines; }
+
+	static constexpr int headPartitionSize = 128;
+	static constexpr int tailPartitionSize = 2048;
+	static constexpr int headLength		   = tailPartitionSize * 2;
+
+private:
+
+	static constexpr int numChannels = 2;
+	static constexpr int numSlots	 = 4;
+
+	struct Kernel
+	{
+		std::vector<std::unique_ptr<PartitionedConvolver>> head, tail;
+
+		int length { 0 };
+	};
+
+	struct Slot
+	{
+		std::vector<float> input, output;
+
+		Kernel* kernel { nullptr };
+
+		std::atomic<std::uint32_t> outputBlock { ~std::uint32_t (0) };
+	};
+
+	[[nodiscard]] std::unique_ptr<Kernel> buildKernel (int& version) const;
+
+	void startWorker();
+	void stopWorker();
+	void workerLoop();
+	void updateKernels();
+	void processTailBlock (std::uint32_t block) noexcept;
+
+	void swapInPendingKernel() noexcept;
+	void handOffTailBlock() noexcept;
+	void wakeWorker() noexcept;
+
+	const ImpulseResponse& impulse;
+
+	double samplerate { 44100. };
+	int	   blocksize { 0 };
+
+	// the audio thread's kernel; replaced only through pending, and retired kernels are freed by the worker
+	Kernel*				 active { nullptr };
+	std::atomic<Kernel*> pending { nullptr }, retired { nullptr };
+
+	std::atomic<std::uint32_t> retiredAfterBlock { 0 };
+
+	std::array<Slot, numSlots> slots;
+
+	std::vector<float> dry, wet, tailInput, tailPlayback;
+
+	int			  tailPosition { 0 };
+	std::uint32_t blocksSent { 0 };
+	int			  requestedVersion { -1 };
+
+	ReverbMixer<SampleType> mixer;
+
+	int missedDeadlines { 0 };
+
+	// only touched by the worker
+	int			  loadedVersion { -1 };
+	std::uint32_t nextBlock { 0 };
+
+	alignas (64) std::atomic<std::uint32_t> sentBlocks { 0 };
+
+	// bumped for every tail block, impulse response change or retired kernel; the worker waits on this
+	std::atomic<std::uint32_t> wakeups { 0 };
+
+	std::atomic<bool> shouldExit { false };
+
+	std::thread worker;
+};
+
+}  // namespace Imogen
@@ -2,40 +2,42 @@
 namespace Imogen
 {
 template <typename SampleType>
-DeEsser<SampleType>::DeEsser (State& stateToUse) : state (stateToUse)
+DeEsser<SampleType>::DeEsser (State& stateToUse, ParameterSnapshot& snapshotToUse)
+	: state (stateToUse), snapshot (snapshotToUse)
 {
+	dynamics.setTimes (attackMs, releaseMs);
+	dynamics.setSidechainHighPass (sidechainFrequency);
 }
 
 template <typename SampleType>
-void DeEsser<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void DeEsser<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet)
 {
 	if (parameters.deEsserToggle->get())
 	{
-		const auto thresh = parameters.deEsserThresh->get();
-		const auto amount = parameters.deEsserAmount->get();
+		if (snapshot.consume (ParameterSnapshot::Group::deEsser))
+			updateSettings (snapshot.deEsser);
 
-		dryDS.setThresh (thresh);
-		dryDS.setDeEssAmount (amount);
-
-		wetDS.setThresh (thresh);
-		wetDS.setDeEssAmount (amount);
-
-		dryDS.process (dry);
-		wetDS.process (wet);
-
-		meters.compRedux->set (static_cast<float> (dryDS.getAverageGainReduction() + wetDS.getAverageGainReduction()) * 0.5f);
+		meters.readings.deEssRedux = dynamics.process (dry, wet, processDry, processWet);
 	}
 	else
 	{
-		meters.deEssRedux->set (0.f);
+		// switched off counts as skipping both paths, so they start clean when it's switched back on
+		meters.readings.deEssRedux = dynamics.process (dry, wet, false, false);
 	}
 }
 
 template <typename SampleType>
-void DeEsser<SampleType>::prepare (double samplerate, int blocksize)
+void DeEsser<SampleType>::updateSettings (const ParameterSnapshot::DeEsser& settings)
+{
+	dynamics.setThreshold (settings.thresh);
+	dynamics.setRatio (juce::jmap (static_cast<float> (settings.amount) * 0.01f, 1.f, 10.f));
+}
+
+template <typename SampleType>
+void DeEsser<SampleType>::prepare (double samplerate, int)
 {
-	dryDS.prepare (samplerate, blocksize);
-	wetDS.prepare (samplerate, blocksize);
+	dynamics.prepare (samplerate);
+	updateSettings ({ parameters.deEsserThresh->get(), parameters.deEsserAmount->get() });
 }
 
 template struct DeEsser<float>;
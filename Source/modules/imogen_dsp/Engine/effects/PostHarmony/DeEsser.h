@@ -7,19 +7,27 @@ struct DeEsser
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	DeEsser (State& stateToUse);
+	DeEsser (State& stateToUse, ParameterSnapshot& snapshotToUse);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet);
 
 	void prepare (double samplerate, int blocksize);
 
 private:
 
+	void updateSettings (const ParameterSnapshot::DeEsser& settings);
+
 	State&		state;
 	Parameters& parameters { state.parameters };
 	Meters&		meters { state.meters };
 
-	dsp::FX::DeEsser<SampleType> dryDS, wetDS;
+	ParameterSnapshot& snapshot;
+
+	static constexpr auto attackMs			 = 0.5;
+	static constexpr auto releaseMs			 = 60.;
+	static constexpr auto sidechainFrequency = 6000.;
+
+	Dynamics<SampleType> dynamics;
 };
 
 }  // namespace Imogen
@@ -2,30 +2,43 @@
 namespace Imogen
 {
 template <typename SampleType>
-Delay<SampleType>::Delay (State& stateToUse) : state (stateToUse)
+Delay<SampleType>::Delay (State& stateToUse, AudioArena<SampleType>& arenaToUse)
+	: state (stateToUse), sleep (arenaToUse)
 {
 }
 
 template <typename SampleType>
 void Delay<SampleType>::process (AudioBuffer& audio)
 {
-	if (parameters.delayToggle->get())
-	{
-		delay.setDryWet (parameters.delayDryWet->get());
-
-		delay.process (audio);
-		meters.delayLevel->set (static_cast<float> (delay.getAverageGainReduction()));
-	}
-	else
-	{
-		meters.delayLevel->set (-60.f);
-	}
+	const auto mix = parameters.delayDryWet->get();
+
+	delay.setDryWet (mix);
+
+	// the delay mixes the dry signal in at 1 - mix
+	const auto delayDryGain = static_cast<SampleType> (1.f - static_cast<float> (mix) * 0.01f);
+
+	const auto mode = sleep.process (
+		audio, parameters.delayToggle->get(), delayDryGain,
+		[this] (AudioBuffer& buffer)
+		{ delay.process (buffer); },
+		[this] (int silentSamples)
+		{ return silentSamples >= delaySamples * echoesToDecay; },
+		[this]
+		{ delay.reset(); });
+
+	meters.readings.delayLevel = mode == TailSleep<SampleType>::Mode::asleep ? -60.f : static_cast<float> (delay.getAverageGainReduction());
+	internals.delaySleepState->set (static_cast<int> (sleep.getMode()));
 }
 
 template <typename SampleType>
 void Delay<SampleType>::prepare (double samplerate, int blocksize)
 {
 	delay.prepare (samplerate, blocksize);
+
+	delaySamples = juce::roundToInt (delaySeconds * samplerate);
+	delay.setDelay (delaySamples);
+
+	sleep.prepare (blocksize, parameters.delayToggle->get(), static_cast<SampleType> (1.f - static_cast<float> (parameters.delayDryWet->get()) * 0.01f));
 }
 
 template struct Delay<float>;
@@ -7,19 +7,34 @@ struct Delay
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	Delay (State& stateToUse);
+	Delay (State& stateToUse, AudioArena<SampleType>& arenaToUse);
 
 	void process (AudioBuffer& audio);
 
 	void prepare (double samplerate, int blocksize);
 
+	bool isAsleep() const noexcept { return sleep.getMode() == TailSleep<SampleType>::Mode::asleep; }
+
+	static constexpr int numArenaChannels = TailSleep<SampleType>::numArenaChannels;
+
 private:
 
+	// there's no delay time parameter yet, so the wrapper sets it, and so knows how long the line rings for
+	static constexpr double delaySeconds = 0.25;
+
+	// the library's delay is a single tap with no feedback path, so one delay time after its input goes quiet, so does it
+	static constexpr int echoesToDecay = 1;
+
 	State&		state;
 	Parameters& parameters { state.parameters };
 	Meters&		meters { state.meters };
+	Internals&	internals { state.internals };
 
 	dsp::FX::Delay<SampleType> delay;
+
+	TailSleep<SampleType> sleep;
+
+	int delaySamples { 0 };
 };
 
 }  // namespace Imogen
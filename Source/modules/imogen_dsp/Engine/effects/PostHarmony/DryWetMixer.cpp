@@ -7,16 +7,25 @@ DryWetMixer<SampleType>::DryWetMixer (Parameters& params) : parameters (params)
 }
 
 template <typename SampleType>
-void DryWetMixer<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void DryWetMixer<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet, int wetMix)
 {
-	mixer.setWetMix (parameters.dryWet->get());
-	mixer.process (dry, wet);
+	forEachAutomationSlice (lastWetMix, wetMix, wet.getNumSamples(), [&] (int startSample, int numSamples, int value)
+							{
+								auto drySlice = sliceOf (dry, startSample, numSamples);
+								auto wetSlice = sliceOf (wet, startSample, numSamples);
+
+								mixer.setWetMix (value);
+								mixer.process (drySlice, wetSlice);
+							});
+
+	lastWetMix = wetMix;
 }
 
 template <typename SampleType>
 void DryWetMixer<SampleType>::prepare (double samplerate, int blocksize)
 {
 	mixer.prepare (2, blocksize, samplerate);
+	lastWetMix = parameters.dryWet->get();
 }
 
 template struct DryWetMixer<float>;
@@ -9,7 +9,10 @@ struct DryWetMixer
 
 	DryWetMixer (Parameters& params);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	/* Ramps from the last block's wet mix to this one over the block. */
+	void process (AudioBuffer& dry, AudioBuffer& wet, int wetMix);
+
+	int getLastWetMix() const noexcept { return lastWetMix; }
 
 	void prepare (double samplerate, int blocksize);
 
@@ -18,6 +21,8 @@ private:
 	Parameters& parameters;
 
 	dsp::FX::DryWetMixer<SampleType> mixer;
+
+	int lastWetMix { 100 };
 };
 
 }  // namespace Imogen
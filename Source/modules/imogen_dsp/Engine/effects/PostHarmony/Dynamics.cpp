@@ -0,0 +1,207 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void Dynamics<SampleType>::prepare (double newSamplerate)
+{
+	jassert (newSamplerate > 0.);
+
+	samplerate = newSamplerate;
+
+	updateCoefficients();
+	resetLanes (0, numLanes);
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::setThreshold (float thresholdDb) noexcept
+{
+	// dB / 20 * log2 (10)
+	thresholdLog2 = static_cast<SampleType> (thresholdDb * 0.16609640474436813);
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::setRatio (float ratio) noexcept
+{
+	jassert (ratio >= 1.f);
+
+	slope = static_cast<SampleType> (1.f / ratio - 1.f);
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::setTimes (double attackMs, double releaseMs) noexcept
+{
+	attackTime	= attackMs;
+	releaseTime = releaseMs;
+
+	updateCoefficients();
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::setSidechainHighPass (double frequency) noexcept
+{
+	sidechainFrequency = frequency;
+
+	updateCoefficients();
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::updateCoefficients() noexcept
+{
+	const auto toCoefficient = [this] (double ms)
+	{ return static_cast<SampleType> (1. - std::exp (-1000. / (ms * samplerate))); };
+
+	attack	= toCoefficient (attackTime);
+	release = toCoefficient (releaseTime);
+
+	if (sidechainFrequency <= 0.)
+		return;
+
+	// RBJ Butterworth high-pass, normalised by a0
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (sidechainFrequency, samplerate * 0.49) / samplerate;
+	const auto alpha = std::sin (omega) / juce::MathConstants<double>::sqrt2;
+	const auto cosw	 = std::cos (omega);
+	const auto a0	 = 1. + alpha;
+
+	b0 = static_cast<SampleType> ((1. + cosw) * 0.5 / a0);
+	b1 = static_cast<SampleType> (-(1. + cosw) / a0);
+	b2 = b0;
+	a1 = static_cast<SampleType> (-2. * cosw / a0);
+	a2 = static_cast<SampleType> ((1. - alpha) / a0);
+}
+
+template <typename SampleType>
+float Dynamics<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet)
+{
+	// a path that skipped some blocks restarts from a closed detector rather than from a stale envelope
+	if (processDry && ! dryWasProcessed)
+		resetLanes (0, 2);
+
+	if (processWet && ! wetWasProcessed)
+		resetLanes (2, 2);
+
+	dryWasProcessed = processDry;
+	wetWasProcessed = processWet;
+
+	jassert (dry.getNumChannels() >= 2 && wet.getNumChannels() >= 2);
+
+	auto sumOfGains = SampleType (0);
+	auto numValues	= 0;
+
+	if (processDry && processWet)
+	{
+		jassert (dry.getNumSamples() == wet.getNumSamples());
+
+		SampleType* const channels[numLanes] { dry.getWritePointer (0), dry.getWritePointer (1),
+											   wet.getWritePointer (0), wet.getWritePointer (1) };
+
+		sumOfGains = dispatchLanes<4> (channels, 0, dry.getNumSamples());
+		numValues  = dry.getNumSamples() * 4;
+	}
+	else if (processDry)
+	{
+		SampleType* const channels[2] { dry.getWritePointer (0), dry.getWritePointer (1) };
+
+		sumOfGains = dispatchLanes<2> (channels, 0, dry.getNumSamples());
+		numValues  = dry.getNumSamples() * 2;
+	}
+	else if (processWet)
+	{
+		SampleType* const channels[2] { wet.getWritePointer (0), wet.getWritePointer (1) };
+
+		sumOfGains = dispatchLanes<2> (channels, 2, wet.getNumSamples());
+		numValues  = wet.getNumSamples() * 2;
+	}
+
+	if (numValues == 0)
+		return 0.f;
+
+	// log2 gain to dB: * 20 * log10 (2)
+	return static_cast<float> (sumOfGains / static_cast<SampleType> (numValues) * SampleType (6.0205999132796239));
+}
+
+template <typename SampleType>
+template <int lanesToProcess>
+SampleType Dynamics<SampleType>::dispatchLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept
+{
+	if (sidechainFrequency > 0.)
+		return processLanes<lanesToProcess, true> (channels, firstLane, numSamples);
+
+	return processLanes<lanesToProcess, false> (channels, firstLane, numSamples);
+}
+
+template <typename SampleType>
+template <int lanesToProcess, bool filterSidechain>
+SampleType Dynamics<SampleType>::processLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept
+{
+	static_assert (lanesToProcess > 0 && lanesToProcess <= numLanes);
+
+	// keeps the log of a silent envelope finite
+	constexpr auto envelopeFloor = SampleType (1.0e-9);
+
+	SampleType env[lanesToProcess], s1[lanesToProcess], s2[lanesToProcess], gainSums[lanesToProcess];
+
+	for (auto lane = 0; lane < lanesToProcess; ++lane)
+	{
+		env[lane]	   = envelopes[firstLane + lane];
+		s1[lane]	   = filterState1[firstLane + lane];
+		s2[lane]	   = filterState2[firstLane + lane];
+		gainSums[lane] = SampleType (0);
+	}
+
+	for (auto i = 0; i < numSamples; ++i)
+	{
+		for (auto lane = 0; lane < lanesToProcess; ++lane)
+		{
+			const auto input = channels[lane][i];
+
+			auto side = input;
+
+			if constexpr (filterSidechain)
+			{
+				side	 = b0 * input + s1[lane];
+				s1[lane] = b1 * input - a1 * side + s2[lane];
+				s2[lane] = b2 * input - a2 * side;
+			}
+
+			const auto level = std::abs (side);
+
+			env[lane] += (level > env[lane] ? attack : release) * (level - env[lane]);
+
+			const auto over		= fastLog2 (std::max (env[lane], envelopeFloor)) - thresholdLog2;
+			const auto gainLog2 = std::min (over * slope, SampleType (0));
+
+			gainSums[lane] += gainLog2;
+
+			channels[lane][i] = input * fastExp2 (gainLog2);
+		}
+	}
+
+	auto total = SampleType (0);
+
+	for (auto lane = 0; lane < lanesToProcess; ++lane)
+	{
+		envelopes[firstLane + lane]	   = env[lane];
+		filterState1[firstLane + lane] = s1[lane];
+		filterState2[firstLane + lane] = s2[lane];
+
+		total += gainSums[lane];
+	}
+
+	return total;
+}
+
+template <typename SampleType>
+void Dynamics<SampleType>::resetLanes (int firstLane, int lanesToReset) noexcept
+{
+	for (auto lane = firstLane; lane < firstLane + lanesToReset; ++lane)
+	{
+		envelopes[lane]	   = SampleType (0);
+		filterState1[lane] = SampleType (0);
+		filterState2[lane] = SampleType (0);
+	}
+}
+
+template class Dynamics<float>;
+template class Dynamics<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <imogen_dsp/Engine/Utils/FastMath.h>
+
+namespace Imogen
+{
+/*
+	A feed-forward compressor that runs dry left, dry right, wet left and wet right as four independent lanes of one loop.
+	Settings and ballistics are computed once for all lanes, and the gain curve is evaluated in the log2 domain
+	with the vectorisable approximations from FastMath.h.
+	With a sidechain high-pass set, the detector only listens above that frequency, which turns this into a de-esser.
+*/
+template <typename SampleType>
+class Dynamics
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	void prepare (double samplerate);
+
+	void setThreshold (float thresholdDb) noexcept;
+	void setRatio (float ratio) noexcept;
+	void setTimes (double attackMs, double releaseMs) noexcept;
+	void setSidechainHighPass (double frequency) noexcept;
+
+	/*
+		Returns the average gain change in decibels across the processed lanes, or 0 if nothing was processed.
+		A path that wasn't processed on the previous call starts again from a cleared state.
+	*/
+	float process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet);
+
+private:
+
+	static constexpr int numLanes = 4;
+
+	template <int lanesToProcess, bool filterSidechain>
+	SampleType processLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept;
+
+	template <int lanesToProcess>
+	SampleType dispatchLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept;
+
+	void resetLanes (int firstLane, int lanesToReset) noexcept;
+
+	void updateCoefficients() noexcept;
+
+	double samplerate { 44100. }, attackTime { 10. }, releaseTime { 100. }, sidechainFrequency { 0. };
+
+	SampleType thresholdLog2 { 0 }, slope { 0 };
+	SampleType attack { 1 }, release { 1 };
+
+	SampleType b0 { 1 }, b1 { 0 }, b2 { 0 }, a1 { 0 }, a2 { 0 };
+
+	alignas (32) SampleType envelopes[numLanes] {};
+	alignas (32) SampleType filterState1[numLanes] {};
+	alignas (32) SampleType filterState2[numLanes] {};
+
+	bool dryWasProcessed { false }, wetWasProcessed { false };
+};
+
+}  // namespace Imogen
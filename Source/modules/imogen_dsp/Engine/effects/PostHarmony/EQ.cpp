@@ -2,110 +2,212 @@
 namespace Imogen
 {
 template <typename SampleType>
-EQ<SampleType>::EQ (EQState& params)
-	: parameters (params)
+EQ<SampleType>::EQ (EQState& params, ParameterSnapshot& snapshotToUse)
+	: parameters (params), snapshot (snapshotToUse)
 {
-	dryEQ.addBand (FT::LowShelf, 80.f);
-	dryEQ.addBand (FT::HighShelf, 10000.f);
-	dryEQ.addBand (FT::HighPass, 80.f);
-	dryEQ.addBand (FT::Peak, 2500.f);
-
-	wetEQ.addBand (FT::LowShelf, 80.f);
-	wetEQ.addBand (FT::HighShelf, 10000.f);
-	wetEQ.addBand (FT::HighPass, 80.f);
-	wetEQ.addBand (FT::Peak, 2500.f);
 }
 
 template <typename SampleType>
-void EQ<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void EQ<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet)
 {
-	if (! parameters.eqToggle->get())
+	const auto isOn = parameters.eqToggle->get();
+
+	// a branch that skipped some blocks, or that comes back with the EQ switched on, restarts from silence rather than from stale filter history
+	if (isOn && processDry && ! dryWasProcessed)
+		resetLanes (0, 2);
+
+	if (isOn && processWet && ! wetWasProcessed)
+		resetLanes (2, 2);
+
+	dryWasProcessed = isOn && processDry;
+	wetWasProcessed = isOn && processWet;
+
+	if (! isOn)
 		return;
 
-	updateLowShelf (parameters.eqLowShelfFreq->get(), parameters.eqLowShelfQ->get(), parameters.eqLowShelfGain->get());
-	updateHighShelf (parameters.eqHighShelfFreq->get(), parameters.eqHighShelfQ->get(), parameters.eqHighShelfGain->get());
-	updatePeak (parameters.eqPeakFreq->get(), parameters.eqPeakQ->get(), parameters.eqPeakGain->get());
-	updateHighPass (parameters.eqHighPassFreq->get(), parameters.eqHighPassQ->get());
+	using Group = ParameterSnapshot::Group;
 
-	dryEQ.process (dry);
-	wetEQ.process (wet);
-}
+	// bands are only recalculated when one of their own settings has moved
+	if (snapshot.consume (Group::eqLowShelf))
+		updateShelf (lowShelf, snapshot.lowShelf);
 
-template <typename SampleType>
-void EQ<SampleType>::updateLowShelf (float freq, float Q, float gain)
-{
-	if (auto* dry = dryEQ.getBandOfType (FT::LowShelf))
+	if (snapshot.consume (Group::eqHighShelf))
+		updateShelf (highShelf, snapshot.highShelf);
+
+	if (snapshot.consume (Group::eqPeak))
+		updatePeak (snapshot.peak);
+
+	if (snapshot.consume (Group::eqHighPass))
+		updateHighPass (snapshot.highPass);
+
+	jassert (dry.getNumChannels() >= 2 && wet.getNumChannels() >= 2);
+
+	if (processDry && processWet)
 	{
-		dry->setFilterFrequency (freq);
-		dry->setQfactor (Q);
-		dry->setGain (gain);
+		jassert (dry.getNumSamples() == wet.getNumSamples());
+
+		SampleType* const channels[numLanes] { dry.getWritePointer (0), dry.getWritePointer (1),
+											   wet.getWritePointer (0), wet.getWritePointer (1) };
+
+		processLanes<4> (channels, 0, dry.getNumSamples());
 	}
+	else if (processDry)
+	{
+		SampleType* const channels[2] { dry.getWritePointer (0), dry.getWritePointer (1) };
 
-	if (auto* wet = wetEQ.getBandOfType (FT::LowShelf))
+		processLanes<2> (channels, 0, dry.getNumSamples());
+	}
+	else if (processWet)
 	{
-		wet->setFilterFrequency (freq);
-		wet->setQfactor (Q);
-		wet->setGain (gain);
+		SampleType* const channels[2] { wet.getWritePointer (0), wet.getWritePointer (1) };
+
+		processLanes<2> (channels, 2, wet.getNumSamples());
 	}
 }
 
 template <typename SampleType>
-void EQ<SampleType>::updateHighShelf (float freq, float Q, float gain)
+template <int lanesToProcess>
+void EQ<SampleType>::processLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept
 {
-	if (auto* dry = dryEQ.getBandOfType (FT::HighShelf))
+	static_assert (lanesToProcess > 0 && lanesToProcess <= numLanes);
+
+	SampleType s1[numBands][lanesToProcess], s2[numBands][lanesToProcess];
+
+	for (auto band = 0; band < numBands; ++band)
 	{
-		dry->setFilterFrequency (freq);
-		dry->setQfactor (Q);
-		dry->setGain (gain);
+		for (auto lane = 0; lane < lanesToProcess; ++lane)
+		{
+			s1[band][lane] = state1[band][firstLane + lane];
+			s2[band][lane] = state2[band][firstLane + lane];
+		}
 	}
 
-	if (auto* wet = wetEQ.getBandOfType (FT::HighShelf))
+	for (auto i = 0; i < numSamples; ++i)
 	{
-		wet->setFilterFrequency (freq);
-		wet->setQfactor (Q);
-		wet->setGain (gain);
+		SampleType x[lanesToProcess];
+
+		for (auto lane = 0; lane < lanesToProcess; ++lane)
+			x[lane] = channels[lane][i];
+
+		// the lane loops have no cross-lane dependencies, so they vectorise into one register per band
+		for (auto band = 0; band < numBands; ++band)
+		{
+			const auto& c = coefficients[static_cast<size_t> (band)];
+
+			for (auto lane = 0; lane < lanesToProcess; ++lane)
+			{
+				const auto y   = c.b0 * x[lane] + s1[band][lane];
+				s1[band][lane] = c.b1 * x[lane] - c.a1 * y + s2[band][lane];
+				s2[band][lane] = c.b2 * x[lane] - c.a2 * y;
+				x[lane]		   = y;
+			}
+		}
+
+		for (auto lane = 0; lane < lanesToProcess; ++lane)
+			channels[lane][i] = x[lane];
+	}
+
+	for (auto band = 0; band < numBands; ++band)
+	{
+		for (auto lane = 0; lane < lanesToProcess; ++lane)
+		{
+			state1[band][firstLane + lane] = s1[band][lane];
+			state2[band][firstLane + lane] = s2[band][lane];
+		}
 	}
 }
 
 template <typename SampleType>
-void EQ<SampleType>::updatePeak (float freq, float Q, float gain)
+void EQ<SampleType>::resetLanes (int firstLane, int lanesToReset) noexcept
 {
-	if (auto* dry = dryEQ.getBandOfType (FT::Peak))
+	for (auto band = 0; band < numBands; ++band)
 	{
-		dry->setFilterFrequency (freq);
-		dry->setQfactor (Q);
-		dry->setGain (gain);
+		for (auto lane = firstLane; lane < firstLane + lanesToReset; ++lane)
+		{
+			state1[band][lane] = SampleType (0);
+			state2[band][lane] = SampleType (0);
+		}
 	}
+}
 
-	if (auto* wet = wetEQ.getBandOfType (FT::Peak))
-	{
-		wet->setFilterFrequency (freq);
-		wet->setQfactor (Q);
-		wet->setGain (gain);
-	}
+/*
+	Coefficients follow the RBJ audio EQ cookbook, normalised by a0.
+	The gain parameters are linear, so A (the square root of the linear gain) is taken directly from them.
+*/
+
+template <typename SampleType>
+void EQ<SampleType>::updateShelf (Band band, const ParameterSnapshot::EqBand& settings)
+{
+	const auto A	 = std::sqrt (std::max (static_cast<double> (settings.gain), 1.0e-3));
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (static_cast<double> (settings.freq), samplerate * 0.49) / samplerate;
+	const auto cosw	 = std::cos (omega);
+	const auto alpha = std::sin (omega) / (2. * std::max (static_cast<double> (settings.q), 0.01));
+	const auto root	 = 2. * std::sqrt (A) * alpha;
+
+	// the high shelf is the low shelf with the sign of every cos(w) term flipped
+	const auto sign = band == highShelf ? -1. : 1.;
+
+	const auto a0 = (A + 1.) + sign * (A - 1.) * cosw + root;
+
+	auto& c = coefficients[static_cast<size_t> (band)];
+
+	c.b0 = static_cast<SampleType> (A * ((A + 1.) - sign * (A - 1.) * cosw + root) / a0);
+	c.b1 = static_cast<SampleType> (sign * 2. * A * ((A - 1.) - sign * (A + 1.) * cosw) / a0);
+	c.b2 = static_cast<SampleType> (A * ((A + 1.) - sign * (A - 1.) * cosw - root) / a0);
+	c.a1 = static_cast<SampleType> (-sign * 2. * ((A - 1.) + sign * (A + 1.) * cosw) / a0);
+	c.a2 = static_cast<SampleType> (((A + 1.) + sign * (A - 1.) * cosw - root) / a0);
 }
 
 template <typename SampleType>
-void EQ<SampleType>::updateHighPass (float freq, float Q)
+void EQ<SampleType>::updatePeak (const ParameterSnapshot::EqBand& settings)
 {
-	if (auto* dry = dryEQ.getBandOfType (FT::HighPass))
-	{
-		dry->setFilterFrequency (freq);
-		dry->setQfactor (Q);
-	}
+	const auto A	 = std::sqrt (std::max (static_cast<double> (settings.gain), 1.0e-3));
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (static_cast<double> (settings.freq), samplerate * 0.49) / samplerate;
+	const auto cosw	 = std::cos (omega);
+	const auto alpha = std::sin (omega) / (2. * std::max (static_cast<double> (settings.q), 0.01));
 
-	if (auto* wet = wetEQ.getBandOfType (FT::HighPass))
-	{
-		wet->setFilterFrequency (freq);
-		wet->setQfactor (Q);
-	}
+	const auto a0 = 1. + alpha / A;
+
+	auto& c = coefficients[peak];
+
+	c.b0 = static_cast<SampleType> ((1. + alpha * A) / a0);
+	c.b1 = static_cast<SampleType> (-2. * cosw / a0);
+	c.b2 = static_cast<SampleType> ((1. - alpha * A) / a0);
+	c.a1 = c.b1;
+	c.a2 = static_cast<SampleType> ((1. - alpha / A) / a0);
 }
 
 template <typename SampleType>
-void EQ<SampleType>::prepare (double samplerate, int blocksize)
+void EQ<SampleType>::updateHighPass (const ParameterSnapshot::EqBand& settings)
 {
-	dryEQ.prepare (samplerate, blocksize);
-	wetEQ.prepare (samplerate, blocksize);
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (static_cast<double> (settings.freq), samplerate * 0.49) / samplerate;
+	const auto cosw	 = std::cos (omega);
+	const auto alpha = std::sin (omega) / (2. * std::max (static_cast<double> (settings.q), 0.01));
+
+	const auto a0 = 1. + alpha;
+
+	auto& c = coefficients[highPass];
+
+	c.b0 = static_cast<SampleType> ((1. + cosw) * 0.5 / a0);
+	c.b1 = static_cast<SampleType> (-(1. + cosw) / a0);
+	c.b2 = c.b0;
+	c.a1 = static_cast<SampleType> (-2. * cosw / a0);
+	c.a2 = static_cast<SampleType> ((1. - alpha) / a0);
+}
+
+template <typename SampleType>
+void EQ<SampleType>::prepare (double newSamplerate, int)
+{
+	jassert (newSamplerate > 0.);
+
+	samplerate = newSamplerate;
+
+	updateShelf (lowShelf, { parameters.eqLowShelfFreq->get(), parameters.eqLowShelfQ->get(), parameters.eqLowShelfGain->get() });
+	updateShelf (highShelf, { parameters.eqHighShelfFreq->get(), parameters.eqHighShelfQ->get(), parameters.eqHighShelfGain->get() });
+	updatePeak ({ parameters.eqPeakFreq->get(), parameters.eqPeakQ->get(), parameters.eqPeakGain->get() });
+	updateHighPass ({ parameters.eqHighPassFreq->get(), parameters.eqHighPassQ->get(), 1.f });
+
+	resetLanes (0, numLanes);
 }
 
 template struct EQ<float>;
@@ -1,31 +1,61 @@
-
 #pragma once
 
 namespace Imogen
 {
+/*
+	One four-band biquad cascade shared by both signal paths: dry left, dry right, wet left and wet right
+	are four lanes of the same transposed direct form II filters, so each band's coefficients are computed
+	once per parameter change and every sample steps all four lanes together.
+*/
 template <typename SampleType>
 struct EQ
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	EQ (EQState& params);
+	EQ (EQState& params, ParameterSnapshot& snapshotToUse);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void process (AudioBuffer& dry, AudioBuffer& wet, bool processDry, bool processWet);
 
 	void prepare (double samplerate, int blocksize);
 
 private:
 
-	using FT = dsp::FX::FilterType;
+	enum Band
+	{
+		lowShelf = 0,
+		highShelf,
+		highPass,
+		peak,
+		numBands
+	};
+
+	static constexpr int numLanes = 4;
+
+	struct Coefficients
+	{
+		SampleType b0 { 1 }, b1 { 0 }, b2 { 0 }, a1 { 0 }, a2 { 0 };
+	};
+
+	template <int lanesToProcess>
+	void processLanes (SampleType* const* channels, int firstLane, int numSamples) noexcept;
+
+	void resetLanes (int firstLane, int lanesToReset) noexcept;
+
+	void updateShelf (Band band, const ParameterSnapshot::EqBand& settings);
+	void updatePeak (const ParameterSnapshot::EqBand& settings);
+	void updateHighPass (const ParameterSnapshot::EqBand& settings);
+
+	EQState&		   parameters;
+	ParameterSnapshot& snapshot;
+
+	double samplerate { 44100. };
 
-	void updateLowShelf (float freq, float Q, float gain);
-	void updateHighShelf (float freq, float Q, float gain);
-	void updatePeak (float freq, float Q, float gain);
-	void updateHighPass (float freq, float Q);
+	std::array<Coefficients, numBands> coefficients;
 
-	EQState& parameters;
+	alignas (32) SampleType state1[numBands][numLanes] {};
+	alignas (32) SampleType state2[numBands][numLanes] {};
 
-	dsp::FX::EQ<SampleType> dryEQ, wetEQ;
+	bool dryWasProcessed { false }, wetWasProcessed { false };
 };
 
 }  // namespace Imogen
@@ -0,0 +1,216 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void FdnReverb<SampleType>::prepare (double newSamplerate, int newBlocksize)
+{
+	jassert (newSamplerate > 0. && newBlocksize > 0);
+
+	samplerate = newSamplerate;
+	blocksize  = newBlocksize;
+
+	auto longest = 0;
+
+	for (auto line = 0; line < numLines; ++line)
+	{
+		delays[line] = juce::roundToInt (lineLengthsMs[line] * 0.001 * samplerate);
+		longest		 = std::max (longest, delays[line]);
+	}
+
+	const auto capacity = juce::nextPowerOfTwo (longest + 1);
+
+	mask = static_cast<unsigned int> (capacity - 1);
+
+	memory.assign (static_cast<size_t> (capacity * numLines), 0.f);
+
+	memoryLength = longest;
+
+	for (auto stage = 0; stage < numDiffusers; ++stage)
+	{
+		auto& diffuser = diffusers[static_cast<size_t> (stage)];
+
+		diffuser.assign (static_cast<size_t> (std::max (1, juce::roundToInt (diffuserLengthsMs[stage] * 0.001 * samplerate))), 0.f);
+
+		memoryLength += static_cast<int> (diffuser.size());
+	}
+
+	dry.assign (static_cast<size_t> (blocksize * 2), 0.f);
+	wet.assign (static_cast<size_t> (blocksize * 2), 0.f);
+
+	mixer.prepare (samplerate);
+
+	updateLoop();
+	reset();
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::reset() noexcept
+{
+	std::fill (memory.begin(), memory.end(), 0.f);
+	std::fill (std::begin (lowpassState), std::end (lowpassState), 0.f);
+
+	for (auto& diffuser : diffusers)
+		std::fill (diffuser.begin(), diffuser.end(), 0.f);
+
+	diffuserPositions.fill (0);
+
+	writePosition = 0;
+	quietSamples  = memoryLength;
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::updateLoop() noexcept
+{
+	// each line loses 60 dB over the decay time, in proportion to its own length
+	for (auto line = 0; line < numLines; ++line)
+		gains[line] = static_cast<float> (std::pow (10., -3. * delays[line] / (decaySeconds * samplerate)));
+
+	// one-pole lowpass coefficient with its corner at the hi cut
+	damping = static_cast<float> (1. - std::exp (-juce::MathConstants<double>::twoPi * std::min (static_cast<double> (hiCutFrequency), samplerate * 0.49) / samplerate));
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::process (AudioBuffer& audio, SampleType* level)
+{
+	const auto numSamples = audio.getNumSamples();
+
+	jassert (numSamples <= blocksize && audio.getNumChannels() > 0);
+
+	auto* dryL = dry.data();
+	auto* dryR = dry.data() + blocksize;
+	auto* wetL = wet.data();
+	auto* wetR = wet.data() + blocksize;
+
+	const auto* inL = audio.getReadPointer (0);
+	const auto* inR = audio.getReadPointer (std::min (1, audio.getNumChannels() - 1));
+
+	// alternating signs spread the input across the lines without correlating them
+	constexpr float inputSigns[numLines] { 1.f, -1.f, 1.f, -1.f, 1.f, -1.f, 1.f, -1.f };
+
+	// 1 / sqrt (numLines) keeps the Hadamard matrix orthonormal, so the loop gain is set by the line gains alone
+	constexpr auto hadamardScale = 0.35355339059327373f;
+
+	auto* lines = memory.data();
+
+	// anything the diffusers still hold reaches the lines within their length, so watching the lines' writes covers both
+	auto peakWritten = 0.f;
+
+	for (auto i = 0; i < numSamples; ++i)
+	{
+		dryL[i] = static_cast<float> (inL[i]);
+		dryR[i] = static_cast<float> (inR[i]);
+
+		auto input = (dryL[i] + dryR[i]) * 0.5f;
+
+		for (auto stage = 0; stage < numDiffusers; ++stage)
+		{
+			auto&	   diffuser = diffusers[static_cast<size_t> (stage)];
+			auto&	   position = diffuserPositions[static_cast<size_t> (stage)];
+			const auto gain		= diffuserGains[stage];
+
+			const auto delayed = diffuser[static_cast<size_t> (position)];
+			const auto output  = delayed - gain * input;
+
+			diffuser[static_cast<size_t> (position)] = input + gain * output;
+
+			if (++position == static_cast<int> (diffuser.size()))
+				position = 0;
+
+			input = output;
+		}
+
+		alignas (32) float v[numLines];
+
+		for (auto line = 0; line < numLines; ++line)
+			v[line] = lines[((writePosition - static_cast<unsigned int> (delays[line])) & mask) * numLines + static_cast<unsigned int> (line)];
+
+		for (auto line = 0; line < numLines; ++line)
+		{
+			lowpassState[line] += damping * (v[line] - lowpassState[line]);
+			v[line] = lowpassState[line] * gains[line];
+		}
+
+		wetL[i] = (v[0] - v[2] + v[4] - v[6]) * 0.5f;
+		wetR[i] = (v[1] - v[3] + v[5] - v[7]) * 0.5f;
+
+		for (auto span = 1; span < numLines; span *= 2)
+		{
+			for (auto start = 0; start < numLines; start += span * 2)
+			{
+				for (auto j = start; j < start + span; ++j)
+				{
+					const auto a = v[j], b = v[j + span];
+
+					v[j]		= a + b;
+					v[j + span] = a - b;
+				}
+			}
+		}
+
+		auto* write = lines + (writePosition & mask) * numLines;
+
+		for (auto line = 0; line < numLines; ++line)
+		{
+			write[line] = v[line] * hadamardScale + input * inputSigns[line];
+			peakWritten = std::max (peakWritten, std::abs (write[line]));
+		}
+
+		++writePosition;
+	}
+
+	if (peakWritten < static_cast<float> (TailSleep<SampleType>::threshold))
+		quietSamples = std::min (quietSamples + numSamples, memoryLength);
+	else
+		quietSamples = 0;
+
+	mixer.process (audio, dryL, dryR, wetL, wetR, numSamples, level);
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setDryWet (int percent) noexcept
+{
+	mixer.setDryWet (percent);
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setDuckAmount (int percent) noexcept
+{
+	mixer.setDuckAmount (percent);
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setLoCutFrequency (float frequency) noexcept
+{
+	mixer.setLoCutFrequency (frequency);
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setHiCutFrequency (float frequency) noexcept
+{
+	hiCutFrequency = frequency;
+
+	mixer.setHiCutFrequency (frequency);
+	updateLoop();
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setWidth (float newWidth) noexcept
+{
+	mixer.setWidth (newWidth);
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::setDecay (int percent) noexcept
+{
+	// exponential, so equal steps of the control sound like equal changes of length
+	const auto proportion = static_cast<double> (percent) * 0.01;
+
+	decaySeconds = static_cast<float> (minDecaySeconds * std::pow (maxDecaySeconds / minDecaySeconds, proportion));
+
+	updateLoop();
+}
+
+template class FdnReverb<float>;
+template class FdnReverb<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ReverbMixer.h"
+#include "TailSleep.h"
+
+namespace Imogen
+{
+/*
+	A feedback delay network reverb: eight delay lines whose outputs are damped, scaled for the decay time,
+	mixed by a fast Hadamard transform and fed back. The input is smeared by a short chain of allpasses first,
+	so the tail starts out dense instead of building up from eight discrete echoes. The lines are stored interleaved, so all eight are written
+	with one contiguous store, and every per-line step works on an eight-lane array the compiler can vectorise.
+	The hi cut sets the lines' damping, so brighter settings also decay more evenly across the spectrum.
+*/
+template <typename SampleType>
+class FdnReverb
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	void prepare (double samplerate, int blocksize);
+
+	void reset() noexcept;
+
+	void setDryWet (int percent) noexcept;
+	void setDuckAmount (int percent) noexcept;
+	void setLoCutFrequency (float frequency) noexcept;
+	void setHiCutFrequency (float frequency) noexcept;
+	void setWidth (float newWidth) noexcept;
+	void setDecay (int percent) noexcept;
+
+	void process (AudioBuffer& audio, SampleType* level);
+
+	/* True once nothing above the tail threshold has been written into the lines or diffusers for as long as they can hold it. */
+	bool linesAreSilent() const noexcept { return quietSamples >= memoryLength; }
+
+	static constexpr int numLines = 8;
+
+private:
+
+	void updateLoop() noexcept;
+
+	static constexpr double lineLengthsMs[numLines] { 31.7, 37.3, 41.9, 47.3, 53.1, 59.9, 67.3, 73.7 };
+
+	// Schroeder allpasses in series, as in Dattorro's input diffuser
+	static constexpr int	numDiffusers = 4;
+	static constexpr double diffuserLengthsMs[numDiffusers] { 4.77, 3.59, 12.73, 9.31 };
+	static constexpr float	diffuserGains[numDiffusers] { 0.75f, 0.75f, 0.625f, 0.625f };
+
+	static constexpr double minDecaySeconds = 0.2;
+	static constexpr double maxDecaySeconds = 8.;
+
+	ReverbMixer<SampleType> mixer;
+
+	double samplerate { 44100. };
+	int	   blocksize { 0 };
+
+	std::vector<float> memory, dry, wet;
+
+	std::array<std::vector<float>, numDiffusers> diffusers;
+	std::array<int, numDiffusers>				 diffuserPositions {};
+
+	unsigned int mask { 0 }, writePosition { 0 };
+
+	int memoryLength { 0 }, quietSamples { 0 };
+
+	alignas (32) int delays[numLines] {};
+	alignas (32) float gains[numLines] {};
+	alignas (32) float lowpassState[numLines] {};
+
+	float damping { 0.f };
+	float decaySeconds { 2.f }, hiCutFrequency { 5500.f };
+};
+
+}  // namespace Imogen
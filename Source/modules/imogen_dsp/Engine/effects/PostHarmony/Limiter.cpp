@@ -14,16 +14,12 @@ void Limiter<SampleType>::process (AudioBuffer& audio)
 	if (parameters.limiterToggle->get())
 	{
 		limiter.process (audio);
-		meters.limRedux->set (static_cast<float> (limiter.getAverageGainReduction()));
+		meters.readings.limRedux = static_cast<float> (limiter.getAverageGainReduction());
 	}
 	else
 	{
-		meters.limRedux->set (0.f);
+		meters.readings.limRedux = 0.f;
 	}
-
-	const auto numSamples = audio.getNumSamples();
-	meters.outputLevelL->set (static_cast<float> (audio.getRMSLevel (0, 0, numSamples)));
-	meters.outputLevelR->set (static_cast<float> (audio.getRMSLevel (1, 0, numSamples)));
 }
 
 template <typename SampleType>
@@ -6,6 +6,7 @@ OutputGain<SampleType>::OutputGain (Parameters& params) : parameters (params)
 {
 }
 
+/* SmoothedGain already ramps to a new gain by itself, so the block isn't split into automation slices here. */
 template <typename SampleType>
 void OutputGain<SampleType>::process (AudioBuffer& audio)
 {
@@ -0,0 +1,133 @@
+
+namespace Imogen
+{
+PartitionedConvolver::PartitionedConvolver (int partitionSizeToUse, const float* impulse, int impulseLength)
+	: partitionSize (partitionSizeToUse),
+	  fftSize (partitionSizeToUse * 2),
+	  numBins (partitionSizeToUse + 1),
+	  numPartitions (std::max (1, (impulseLength + partitionSizeToUse - 1) / partitionSizeToUse)),
+	  fft (juce::roundToInt (std::log2 (partitionSizeToUse * 2)))
+{
+	jassert (juce::isPowerOfTwo (partitionSize));
+
+	const auto spectrumSize = static_cast<size_t> (numBins * 2);
+
+	partitions.assign (spectrumSize * static_cast<size_t> (numPartitions), 0.f);
+	history.assign (spectrumSize * static_cast<size_t> (numPartitions), 0.f);
+	accumulated.assign (spectrumSize, 0.f);
+	workspace.assign (static_cast<size_t> (fftSize * 2), 0.f);
+	currentInput.assign (static_cast<size_t> (partitionSize), 0.f);
+	overlap.assign (static_cast<size_t> (partitionSize), 0.f);
+
+	for (auto partition = 0; partition < numPartitions; ++partition)
+	{
+		std::fill (workspace.begin(), workspace.end(), 0.f);
+
+		const auto start = partition * partitionSize;
+		const auto count = std::min (partitionSize, impulseLength - start);
+
+		if (count > 0)
+			std::copy (impulse + start, impulse + start + count, workspace.begin());
+
+		fft.performRealOnlyForwardTransform (workspace.data(), true);
+
+		std::copy (workspace.begin(), workspace.begin() + static_cast<std::ptrdiff_t> (spectrumSize), partitionSpectrum (partition));
+	}
+
+	reset();
+}
+
+void PartitionedConvolver::reset() noexcept
+{
+	std::fill (history.begin(), history.end(), 0.f);
+	std::fill (accumulated.begin(), accumulated.end(), 0.f);
+	std::fill (currentInput.begin(), currentInput.end(), 0.f);
+	std::fill (overlap.begin(), overlap.end(), 0.f);
+
+	historyIndex  = 0;
+	inputPosition = 0;
+}
+
+void PartitionedConvolver::process (const float* input, float* output, int numSamples) noexcept
+{
+	while (numSamples > 0)
+	{
+		const auto count = std::min (numSamples, partitionSize - inputPosition);
+
+		std::copy (input, input + count, currentInput.begin() + inputPosition);
+
+		// the spectrum of the block so far becomes the newest entry of the delay line
+		std::fill (workspace.begin(), workspace.end(), 0.f);
+		std::copy (currentInput.begin(), currentInput.end(), workspace.begin());
+
+		fft.performRealOnlyForwardTransform (workspace.data(), true);
+
+		auto* newest = historySpectrum (0);
+		std::copy (workspace.begin(), workspace.begin() + numBins * 2, newest);
+
+		std::copy (accumulated.begin(), accumulated.end(), workspace.begin());
+		multiplyAccumulate (workspace.data(), newest, partitionSpectrum (0), numBins);
+
+		// the inverse transform wants the full conjugate-symmetric spectrum
+		for (auto bin = numBins; bin < fftSize; ++bin)
+		{
+			const auto mirror = static_cast<size_t> ((fftSize - bin) * 2);
+
+			workspace[static_cast<size_t> (bin * 2)]	 = workspace[mirror];
+			workspace[static_cast<size_t> (bin * 2 + 1)] = -workspace[mirror + 1];
+		}
+
+		fft.performRealOnlyInverseTransform (workspace.data());
+
+		for (auto i = 0; i < count; ++i)
+			output[i] = workspace[static_cast<size_t> (inputPosition + i)] + overlap[static_cast<size_t> (inputPosition + i)];
+
+		inputPosition += count;
+
+		if (inputPosition == partitionSize)
+			finishBlock();
+
+		input += count;
+		output += count;
+		numSamples -= count;
+	}
+}
+
+void PartitionedConvolver::finishBlock() noexcept
+{
+	std::copy (workspace.begin() + partitionSize, workspace.begin() + fftSize, overlap.begin());
+	std::fill (currentInput.begin(), currentInput.end(), 0.f);
+
+	inputPosition = 0;
+
+	// the oldest slot is recycled for the block that starts now
+	historyIndex = (historyIndex + numPartitions - 1) % numPartitions;
+
+	std::fill (accumulated.begin(), accumulated.end(), 0.f);
+
+	for (auto age = 1; age < numPartitions; ++age)
+		multiplyAccumulate (accumulated.data(), historySpectrum (age), partitionSpectrum (age), numBins);
+}
+
+void PartitionedConvolver::multiplyAccumulate (float* destination, const float* a, const float* b, int numBins) noexcept
+{
+	for (auto bin = 0; bin < numBins; ++bin)
+	{
+		const auto re = bin * 2, im = re + 1;
+
+		destination[re] += a[re] * b[re] - a[im] * b[im];
+		destination[im] += a[re] * b[im] + a[im] * b[re];
+	}
+}
+
+float* PartitionedConvolver::partitionSpectrum (int partition) noexcept
+{
+	return partitions.data() + static_cast<size_t> (partition * numBins * 2);
+}
+
+float* PartitionedConvolver::historySpectrum (int age) noexcept
+{
+	return history.data() + static_cast<size_t> ((historyIndex + age) % numPartitions * numBins * 2);
+}
+
+}  // namespace Imogen
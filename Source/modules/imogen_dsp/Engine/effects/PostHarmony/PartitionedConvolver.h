@@ -0,0 +1,47 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+
+namespace Imogen
+{
+/*
+	Uniformly partitioned FFT convolution with one impulse response segment.
+	The input is taken in blocks of partitionSize; older blocks stay in a frequency-domain delay line, and their
+	contribution to the current block is summed once per partition. Within a block the current partial input is
+	re-transformed on every call, so any call size works and no latency is added.
+	The constructor transforms the impulse response, so it allocates: build these off the audio thread.
+*/
+class PartitionedConvolver
+{
+public:
+
+	PartitionedConvolver (int partitionSizeToUse, const float* impulse, int impulseLength);
+
+	void reset() noexcept;
+
+	/* Writes the convolution of the next numSamples of input into output. */
+	void process (const float* input, float* output, int numSamples) noexcept;
+
+	int getPartitionSize() const noexcept { return partitionSize; }
+
+private:
+
+	void finishBlock() noexcept;
+
+	static void multiplyAccumulate (float* destination, const float* a, const float* b, int numBins) noexcept;
+
+	float* partitionSpectrum (int partition) noexcept;
+	float* historySpectrum (int age) noexcept;
+
+	const int partitionSize, fftSize, numBins, numPartitions;
+
+	juce::dsp::FFT fft;
+
+	// each spectrum holds numBins interleaved complex values
+	std::vector<float> partitions, history;
+	std::vector<float> accumulated, workspace, currentInput, overlap;
+
+	int historyIndex { 0 }, inputPosition { 0 };
+};
+
+}  // namespace Imogen
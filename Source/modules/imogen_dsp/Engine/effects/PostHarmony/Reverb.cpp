@@ -2,44 +2,130 @@
 namespace Imogen
 {
 template <typename SampleType>
-Reverb<SampleType>::Reverb (State& stateToUse) : state (stateToUse)
+Reverb<SampleType>::Reverb (State& stateToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse)
+	: state (stateToUse), snapshot (snapshotToUse), sleep (arenaToUse)
 {
 }
 
 template <typename SampleType>
 void Reverb<SampleType>::process (AudioBuffer& audio)
 {
-	if (parameters.reverbToggle->get())
+	updateSettings();
+
+	SampleType level { 0 };
+
+	// every engine mixes the dry signal in at 1 - mix
+	const auto engineDryGain = static_cast<SampleType> (1.f - static_cast<float> (snapshot.reverb.dryWet) * 0.01f);
+
+	const auto mode = sleep.process (
+		audio, parameters.reverbToggle->get(), engineDryGain,
+		[this, &level] (AudioBuffer& buffer)
+		{ runEngine (buffer, level); },
+		[this] (int silentSamples)
+		{ return tailHasDecayed (silentSamples); },
+		[this]
+		{ clearEngines(); });
+
+	meters.readings.reverbLevel = mode == TailSleep<SampleType>::Mode::asleep ? -60.f : static_cast<float> (level);
+	internals.reverbSleepState->set (static_cast<int> (sleep.getMode()));
+	internals.convolutionMissedDeadlines->set (convolution.getNumMissedDeadlines());
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::runEngine (AudioBuffer& audio, SampleType& level)
+{
+	const auto engine = parameters.reverbEngine->get();
+
+	if (engine == 2)
 	{
-		reverb.setDryWet (parameters.reverbDryWet->get());
-		reverb.setDuckAmount (parameters.reverbDuck->get());
-		reverb.setLoCutFrequency (parameters.reverbLoCut->get());
-		reverb.setHiCutFrequency (parameters.reverbHiCut->get());
-
-		const auto d = static_cast<float> (parameters.reverbDecay->get()) * 0.01f;
-		reverb.setDamping (1.f - d);
-		reverb.setRoomSize (d);
-
-		SampleType level;
-		reverb.process (audio, &level);
-		meters.reverbLevel->set (static_cast<float> (level));
+		fdn.process (audio, &level);
+		lastEngine = ReverbEngine::network;
+		return;
 	}
-	else
+
+	// the classic reverb stands in until an impulse response has been loaded
+	if (engine == 3 && convolution.process (audio, &level))
 	{
-		meters.reverbLevel->set (-60.f);
+		lastEngine = ReverbEngine::convolution;
+		return;
 	}
+
+	reverb.process (audio, &level);
+	lastEngine = ReverbEngine::classic;
 }
 
 template <typename SampleType>
-void Reverb<SampleType>::prepare (double samplerate, int blocksize)
+bool Reverb<SampleType>::tailHasDecayed (int silentSamples) const noexcept
 {
+	if (lastEngine == ReverbEngine::network)
+		return fdn.linesAreSilent();
+
+	if (lastEngine == ReverbEngine::convolution)
+		return silentSamples >= convolution.getTailLength();
+
+	// the classic engine is Freeverb, whose longest comb and allpasses add up to 3295 samples at 44.1 kHz,
+	// and whose combs feed back at 0.7 + 0.28 * room size on each pass; damping only makes the tail shorter
+	const auto feedback = 0.7 + 0.28 * static_cast<double> (snapshot.reverb.decay) * 0.01;
+	const auto passes	= std::ceil (std::log (static_cast<double> (TailSleep<SampleType>::threshold)) / std::log (feedback));
+
+	return silentSamples >= static_cast<int> (passes * 3295. * samplerate / 44100.);
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::clearEngines() noexcept
+{
+	reverb.reset();
+	fdn.reset();
+	convolution.reset();
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::updateSettings()
+{
+	if (! snapshot.consume (ParameterSnapshot::Group::reverb))
+		return;
+
+	const auto& settings = snapshot.reverb;
+
+	reverb.setDryWet (settings.dryWet);
+	reverb.setDuckAmount (settings.duck);
+	reverb.setLoCutFrequency (settings.loCut);
+	reverb.setHiCutFrequency (settings.hiCut);
+
+	fdn.setDryWet (settings.dryWet);
+	fdn.setDuckAmount (settings.duck);
+	fdn.setLoCutFrequency (settings.loCut);
+	fdn.setHiCutFrequency (settings.hiCut);
+	fdn.setDecay (settings.decay);
+
+	convolution.setDryWet (settings.dryWet);
+	convolution.setDuckAmount (settings.duck);
+	convolution.setLoCutFrequency (settings.loCut);
+	convolution.setHiCutFrequency (settings.hiCut);
+
+	const auto d = static_cast<float> (settings.decay) * 0.01f;
+	reverb.setDamping (1.f - d);
+	reverb.setRoomSize (d);
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::prepare (double newSamplerate, int blocksize)
+{
+	samplerate = newSamplerate;
+
 	reverb.prepare (blocksize, samplerate, 2);
+	fdn.prepare (samplerate, blocksize);
+	convolution.prepare (samplerate, blocksize);
+
+	sleep.prepare (blocksize, parameters.reverbToggle->get(), static_cast<SampleType> (1.f - static_cast<float> (parameters.reverbDryWet->get()) * 0.01f));
 }
 
 template <typename SampleType>
 void Reverb<SampleType>::setWidth (float width)
 {
 	reverb.setWidth (width);
+	fdn.setWidth (width);
+	convolution.setWidth (width);
 }
 
 template struct Reverb<float>;
@@ -7,7 +7,7 @@ struct Reverb
 {
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	Reverb (State& stateToUse);
+	Reverb (State& stateToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse);
 
 	void process (AudioBuffer& audio);
 
@@ -15,13 +15,44 @@ struct Reverb
 
 	void setWidth (float width);
 
+	bool isAsleep() const noexcept { return sleep.getMode() == TailSleep<SampleType>::Mode::asleep; }
+
+	static constexpr int numArenaChannels = TailSleep<SampleType>::numArenaChannels;
+
 private:
 
+	enum class ReverbEngine
+	{
+		classic,
+		network,
+		convolution
+	};
+
+	void updateSettings();
+
+	void runEngine (AudioBuffer& audio, SampleType& level);
+
+	[[nodiscard]] bool tailHasDecayed (int silentSamples) const noexcept;
+
+	void clearEngines() noexcept;
+
 	State&		 state;
 	ReverbState& parameters { state.parameters.reverbState };
 	Meters&		 meters { state.meters };
+	Internals&	 internals { state.internals };
+
+	ParameterSnapshot& snapshot;
+
+	dsp::FX::Reverb				  reverb;
+	FdnReverb<SampleType>		  fdn;
+	ConvolutionReverb<SampleType> convolution { state.impulseResponse };
+
+	TailSleep<SampleType> sleep;
+
+	// the engine that last ran, which decides how long the tail lasts
+	ReverbEngine lastEngine { ReverbEngine::classic };
 
-	dsp::FX::Reverb reverb;
+	double samplerate { 44100. };
 };
 
 }  // namespace Imogen
@@ -0,0 +1,150 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void ReverbMixer<SampleType>::prepare (double newSamplerate)
+{
+	jassert (newSamplerate > 0.);
+
+	samplerate = newSamplerate;
+
+	loCut = {};
+	hiCut = {};
+	loCut.setHighPass (loCutFrequency, samplerate);
+	hiCut.setLowPass (hiCutFrequency, samplerate);
+
+	const auto toCoefficient = [this] (double ms)
+	{ return static_cast<float> (1. - std::exp (-1000. / (ms * samplerate))); };
+
+	duckAttack	 = toCoefficient (10.);
+	duckRelease	 = toCoefficient (250.);
+	duckEnvelope = 0.f;
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::process (AudioBuffer& audio, const float* dryL, const float* dryR, float* wetL, float* wetR,
+									   int numSamples, SampleType* level) noexcept
+{
+	auto sumOfSquares = 0.f;
+
+	for (auto i = 0; i < numSamples; ++i)
+	{
+		auto l = hiCut.process (loCut.process (wetL[i], 0), 0);
+		auto r = hiCut.process (loCut.process (wetR[i], 1), 1);
+
+		const auto mid	= (l + r) * 0.5f;
+		const auto side = (l - r) * 0.5f * width;
+
+		const auto input = std::max (std::abs (dryL[i]), std::abs (dryR[i]));
+		duckEnvelope += (input > duckEnvelope ? duckAttack : duckRelease) * (input - duckEnvelope);
+
+		const auto wetGain = mix * (1.f - duck * std::min (duckEnvelope / duckFullScale, 1.f));
+
+		l = (mid + side) * wetGain;
+		r = (mid - side) * wetGain;
+
+		wetL[i] = l;
+		wetR[i] = r;
+
+		sumOfSquares += l * l + r * r;
+	}
+
+	const auto dryGain = static_cast<SampleType> (1.f - mix);
+
+	for (auto chan = 0; chan < audio.getNumChannels(); ++chan)
+	{
+		auto*		output = audio.getWritePointer (chan);
+		const auto* wet	   = chan == 0 ? wetL : wetR;
+
+		for (auto i = 0; i < numSamples; ++i)
+			output[i] = output[i] * dryGain + static_cast<SampleType> (wet[i]);
+	}
+
+	if (level != nullptr)
+	{
+		const auto rms = numSamples > 0 ? std::sqrt (sumOfSquares / static_cast<float> (numSamples * 2)) : 0.f;
+
+		*level = static_cast<SampleType> (juce::Decibels::gainToDecibels (rms, -60.f));
+	}
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::setDryWet (int percent) noexcept
+{
+	mix = static_cast<float> (percent) * 0.01f;
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::setDuckAmount (int percent) noexcept
+{
+	duck = static_cast<float> (percent) * 0.01f;
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::setLoCutFrequency (float frequency) noexcept
+{
+	loCutFrequency = frequency;
+	loCut.setHighPass (frequency, samplerate);
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::setHiCutFrequency (float frequency) noexcept
+{
+	hiCutFrequency = frequency;
+	hiCut.setLowPass (frequency, samplerate);
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::setWidth (float newWidth) noexcept
+{
+	width = newWidth;
+}
+
+/* RBJ Butterworth filters, normalised by a0. */
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::Biquad::setHighPass (double frequency, double sr) noexcept
+{
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (frequency, sr * 0.49) / sr;
+	const auto alpha = std::sin (omega) / juce::MathConstants<double>::sqrt2;
+	const auto cosw	 = std::cos (omega);
+	const auto a0	 = 1. + alpha;
+
+	b0 = static_cast<float> ((1. + cosw) * 0.5 / a0);
+	b1 = static_cast<float> (-(1. + cosw) / a0);
+	b2 = b0;
+	a1 = static_cast<float> (-2. * cosw / a0);
+	a2 = static_cast<float> ((1. - alpha) / a0);
+}
+
+template <typename SampleType>
+void ReverbMixer<SampleType>::Biquad::setLowPass (double frequency, double sr) noexcept
+{
+	const auto omega = juce::MathConstants<double>::twoPi * std::min (frequency, sr * 0.49) / sr;
+	const auto alpha = std::sin (omega) / juce::MathConstants<double>::sqrt2;
+	const auto cosw	 = std::cos (omega);
+	const auto a0	 = 1. + alpha;
+
+	b0 = static_cast<float> ((1. - cosw) * 0.5 / a0);
+	b1 = static_cast<float> ((1. - cosw) / a0);
+	b2 = b0;
+	a1 = static_cast<float> (-2. * cosw / a0);
+	a2 = static_cast<float> ((1. - alpha) / a0);
+}
+
+template <typename SampleType>
+float ReverbMixer<SampleType>::Biquad::process (float input, int channel) noexcept
+{
+	auto& s = state[channel];
+
+	const auto output = b0 * input + s[0];
+	s[0]			  = b1 * input - a1 * output + s[1];
+	s[1]			  = b2 * input - a2 * output;
+
+	return output;
+}
+
+template class ReverbMixer<float>;
+template class ReverbMixer<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,51 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	The wet-signal controls shared by Imogen's own reverb engines: lo and hi cut, stereo width,
+	ducking under the dry input, and the dry/wet mix back into the audio. Works in single precision.
+*/
+template <typename SampleType>
+class ReverbMixer
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	void prepare (double samplerate);
+
+	void setDryWet (int percent) noexcept;
+	void setDuckAmount (int percent) noexcept;
+	void setLoCutFrequency (float frequency) noexcept;
+	void setHiCutFrequency (float frequency) noexcept;
+	void setWidth (float newWidth) noexcept;
+
+	/* Shapes the stereo wet signal in place, then mixes it into audio. dry is the engine's input, used for ducking. */
+	void process (AudioBuffer& audio, const float* dryL, const float* dryR, float* wetL, float* wetR, int numSamples, SampleType* level) noexcept;
+
+private:
+
+	static constexpr auto duckFullScale = 0.25f;  // -12 dBFS of input ducks the reverb by the full amount
+
+	struct Biquad
+	{
+		float b0 { 1.f }, b1 { 0.f }, b2 { 0.f }, a1 { 0.f }, a2 { 0.f };
+		float state[2][2] {};
+
+		void setHighPass (double frequency, double samplerate) noexcept;
+		void setLowPass (double frequency, double samplerate) noexcept;
+
+		float process (float input, int channel) noexcept;
+	};
+
+	double samplerate { 44100. };
+
+	Biquad loCut, hiCut;
+
+	float loCutFrequency { 80.f }, hiCutFrequency { 5500.f };
+	float mix { 0.15f }, duck { 0.3f }, width { 1.f };
+	float duckEnvelope { 0.f }, duckAttack { 0.f }, duckRelease { 0.f };
+};
+
+}  // namespace Imogen
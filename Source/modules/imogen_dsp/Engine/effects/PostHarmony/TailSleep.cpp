@@ -0,0 +1,25 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+TailSleep<SampleType>::TailSleep (AudioArena<SampleType>& arenaToUse)
+	: arena (arenaToUse)
+{
+}
+
+template <typename SampleType>
+void TailSleep<SampleType>::prepare (int blocksize, bool isEnabled, SampleType effectDryGain)
+{
+	arena.claim (tailBuffer, numArenaChannels, blocksize);
+
+	// a freshly prepared effect has nothing to ring out, so it sleeps until it first hears something
+	mode.store (Mode::asleep, std::memory_order_relaxed);
+	silentSamples = 0;
+
+	dryGain = isEnabled ? effectDryGain : SampleType (1);
+}
+
+template class TailSleep<float>;
+template class TailSleep<double>;
+
+}  // namespace Imogen
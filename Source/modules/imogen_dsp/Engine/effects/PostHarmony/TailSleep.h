@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+
+#include <imogen_dsp/Engine/Utils/AudioArena.h>
+#include <imogen_dsp/Engine/Utils/AutomationSlices.h>
+
+namespace Imogen
+{
+/*
+	Lets a time-based effect stop processing once both its input and its tail have gone inaudible.
+	The effect itself decides when its tail has decayed, from what's left in its lines or from how long it has heard only silence,
+	and its lines are cleared when it goes to sleep, so waking it on the next audible input starts from silence and can't click.
+	When the effect is switched off it keeps running on silence, so the tail rings out, and then goes to sleep.
+	The effect mixes its own dry signal in, and a stage that isn't running passes it at unity, so whenever the gain
+	the dry signal is passed at changes between blocks, the difference is crossfaded out over the block.
+*/
+template <typename SampleType>
+class TailSleep
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	enum class Mode : int
+	{
+		awake	   = 0,
+		ringingOut = 1,
+		asleep	   = 2
+	};
+
+	explicit TailSleep (AudioArena<SampleType>& arenaToUse);
+
+	/* effectDryGain is the gain the effect passes its dry signal at while it's enabled. */
+	void prepare (int blocksize, bool isEnabled, SampleType effectDryGain);
+
+	/*
+		Runs one block of the effect, unless it's asleep. render (buffer) processes a buffer in place.
+		hasDecayed (silentSamples) is asked after every block the effect heard nothing in, with how many samples
+		it has heard nothing for, and clear() is called as it goes to sleep.
+	*/
+	template <typename Render, typename HasDecayed, typename Clear>
+	Mode process (AudioBuffer& audio, bool isEnabled, SampleType effectDryGain, Render&& render, HasDecayed&& hasDecayed, Clear&& clear);
+
+	/* Safe to call from any thread. */
+	Mode getMode() const noexcept { return mode.load (std::memory_order_relaxed); }
+
+	static constexpr int numArenaChannels = 2;
+
+	static constexpr auto threshold = SampleType (1.0e-5);	// -100 dB
+
+private:
+
+	AudioArena<SampleType>& arena;
+
+	AudioBuffer tailBuffer;
+
+	std::atomic<Mode> mode { Mode::asleep };
+
+	int silentSamples { 0 };
+
+	// the gain the dry signal was passed at by the end of the last block
+	SampleType dryGain { 1 };
+};
+
+
+template <typename SampleType>
+template <typename Render, typename HasDecayed, typename Clear>
+typename TailSleep<SampleType>::Mode TailSleep<SampleType>::process (AudioBuffer& audio, bool isEnabled, SampleType effectDryGain,
+																	  Render&& render, HasDecayed&& hasDecayed, Clear&& clear)
+{
+	const auto numSamples	 = audio.getNumSamples();
+	const auto inputIsSilent = audio.getMagnitude (0, numSamples) < threshold;
+
+	// a switched off effect hears nothing, whatever its input
+	if (inputIsSilent || ! isEnabled)
+		silentSamples = std::min (silentSamples, std::numeric_limits<int>::max() - numSamples) + numSamples;
+	else
+		silentSamples = 0;
+
+	if (getMode() == Mode::asleep && silentSamples > 0)
+		return Mode::asleep;
+
+	const auto newMode = isEnabled ? Mode::awake : Mode::ringingOut;
+
+	mode.store (newMode, std::memory_order_relaxed);
+
+	if (newMode == Mode::awake)
+	{
+		if (dryGain == effectDryGain)
+		{
+			render (audio);
+		}
+		else
+		{
+			// the effect jumps straight to its own dry gain, so the difference from the last block's is faded out on top of it
+			auto dry = sliceOf (tailBuffer, 0, numSamples);
+
+			for (auto chan = 0; chan < dry.getNumChannels(); ++chan)
+				dry.copyFrom (chan, 0, audio, chan % audio.getNumChannels(), 0, numSamples);
+
+			render (audio);
+
+			for (auto chan = 0; chan < audio.getNumChannels(); ++chan)
+				audio.addFromWithRamp (chan, 0, dry.getReadPointer (chan % dry.getNumChannels()), numSamples,
+									   dryGain - effectDryGain, SampleType (0));
+
+			dryGain = effectDryGain;
+		}
+	}
+	else
+	{
+		// switched off: the effect only hears silence from here on, and what it returns is added back as the tail
+		auto tail = sliceOf (tailBuffer, 0, numSamples);
+		tail.clear();
+
+		render (tail);
+
+		// the dry signal goes back to unity gradually, rather than jumping up as soon as the effect is switched off
+		if (dryGain != SampleType (1))
+		{
+			audio.applyGainRamp (0, numSamples, dryGain, SampleType (1));
+			dryGain = SampleType (1);
+		}
+
+		for (auto chan = 0; chan < audio.getNumChannels(); ++chan)
+			audio.addFrom (chan, 0, tail, chan % tail.getNumChannels(), 0, numSamples);
+	}
+
+	if (silentSamples == 0 || ! hasDecayed (silentSamples))
+		return newMode;
+
+	clear();
+
+	mode.store (Mode::asleep, std::memory_order_relaxed);
+
+	return newMode;
+}
+
+}  // namespace Imogen
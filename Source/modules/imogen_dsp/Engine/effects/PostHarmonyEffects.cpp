@@ -1,8 +1,8 @@
 namespace Imogen
 {
 template <typename SampleType>
-PostHarmonyEffects<SampleType>::PostHarmonyEffects (State& stateToUse)
-	: state (stateToUse)
+PostHarmonyEffects<SampleType>::PostHarmonyEffects (State& stateToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse)
+	: state (stateToUse), snapshot (snapshotToUse), arena (arenaToUse)
 {
 }
 
@@ -23,18 +23,45 @@ void PostHarmonyEffects<SampleType>::prepare (double samplerate, int blocksize)
 template <typename SampleType>
 void PostHarmonyEffects<SampleType>::process (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output)
 {
-	eq.process (drySignal, harmonySignal);
-	compressor.process (drySignal, harmonySignal);
-	deEsser.process (drySignal, harmonySignal);
+	// a branch that the mixer would throw away isn't processed. When it's needed again its EQ and dynamics start from cleared state,
+	// and it fades in over one chunk. This is the only fade, including for the lead coming back from bypass
+	const auto wetMix	  = parameters.dryWet->get();
+	const auto lastWetMix = dryWetMixer.getLastWetMix();
 
-	dryWetMixer.process (drySignal, harmonySignal);
+	// the mixer ramps from the last block's mix to this one, so a branch is used if either end of the ramp hears it
+	const auto dryIsUsed = (lastWetMix < 100 || wetMix < 100) && ! parameters.leadBypass->get();
+	const auto wetIsUsed = (lastWetMix > 0 || wetMix > 0) && ! parameters.harmonyBypass->get();
+
+	eq.process (drySignal, harmonySignal, dryIsUsed, wetIsUsed);
+	compressor.process (drySignal, harmonySignal, dryIsUsed, wetIsUsed);
+	deEsser.process (drySignal, harmonySignal, dryIsUsed, wetIsUsed);
+
+	if (dryIsUsed && ! dryWasUsed)
+		fadeIn (drySignal);
+
+	if (wetIsUsed && ! wetWasUsed)
+		fadeIn (harmonySignal);
+
+	dryWasUsed = dryIsUsed;
+	wetWasUsed = wetIsUsed;
+
+	dryWetMixer.process (drySignal, harmonySignal, wetMix);
 
 	delay.process (harmonySignal);
 	reverb.process (harmonySignal);
 	outputGain.process (harmonySignal);
 	limiter.process (harmonySignal);
 
-	dsp::buffers::copy (harmonySignal, output);
+	// when the chain was run in the output buffer itself there's nothing left to copy
+	if (harmonySignal.getReadPointer (0) != output.getReadPointer (0))
+		dsp::buffers::copy (harmonySignal, output);
+}
+
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::fadeIn (AudioBuffer& audio)
+{
+	for (auto chan = 0; chan < audio.getNumChannels(); ++chan)
+		audio.applyGainRamp (chan, 0, audio.getNumSamples(), SampleType (0), SampleType (1));
 }
 
 template <typename SampleType>
@@ -2,15 +2,23 @@
 
 #include <lemons_audio_effects/lemons_audio_effects.h>
 
-#include "PreHarmony/StereoReducer.h"
-#include "PreHarmony/InputGain.h"
-#include "PreHarmony/NoiseGate.h"
+#include <imogen_dsp/Engine/ParameterSnapshot.h>
+#include <imogen_dsp/Engine/Utils/AutomationSlices.h>
+#include <imogen_dsp/Engine/Utils/AudioArena.h>
+
+#include "PreHarmony/InputStage.h"
 
 #include "PostHarmony/EQ.h"
+#include "PostHarmony/Dynamics.h"
 #include "PostHarmony/Compressor.h"
 #include "PostHarmony/DeEsser.h"
 #include "PostHarmony/DryWetMixer.h"
+#include "PostHarmony/TailSleep.h"
 #include "PostHarmony/Delay.h"
+#include "PostHarmony/ReverbMixer.h"
+#include "PostHarmony/FdnReverb.h"
+#include "PostHarmony/PartitionedConvolver.h"
+#include "PostHarmony/ConvolutionReverb.h"
 #include "PostHarmony/Reverb.h"
 #include "PostHarmony/OutputGain.h"
 #include "PostHarmony/Limiter.h"
@@ -24,7 +32,7 @@ public:
 
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	PostHarmonyEffects (State& stateToUse);
+	PostHarmonyEffects (State& stateToUse, ParameterSnapshot& snapshotToUse, AudioArena<SampleType>& arenaToUse);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -32,20 +40,32 @@ public:
 
 	void updateStereoWidth (int width);
 
+	/* True once the delay and reverb have both rung out and gone to sleep. Safe to call while the chain is running on another thread. */
+	bool tailsAreAsleep() const noexcept { return delay.isAsleep() && reverb.isAsleep(); }
+
+	static constexpr int numArenaChannels = Delay<SampleType>::numArenaChannels + Reverb<SampleType>::numArenaChannels;
+
 private:
 
+	static void fadeIn (AudioBuffer& audio);
+
 	State&		state;
 	Parameters& parameters { state.parameters };
 
-	EQ<SampleType>		   eq { parameters.eqState };
-	Compressor<SampleType> compressor { state };
-	DeEsser<SampleType>	   deEsser { state };
+	ParameterSnapshot&		snapshot;
+	AudioArena<SampleType>& arena;
+
+	EQ<SampleType>		   eq { parameters.eqState, snapshot };
+	Compressor<SampleType> compressor { state, snapshot };
+	DeEsser<SampleType>	   deEsser { state, snapshot };
 
 	DryWetMixer<SampleType> dryWetMixer { parameters };
-	Delay<SampleType>		delay { state };
-	Reverb<SampleType>		reverb { state };
+	Delay<SampleType>		delay { state, arena };
+	Reverb<SampleType>		reverb { state, snapshot, arena };
 	OutputGain<SampleType>	outputGain { parameters };
 	Limiter<SampleType>		limiter { state };
+
+	bool dryWasUsed { true }, wetWasUsed { true };
 };
 
 }  // namespace Imogen
@@ -0,0 +1,113 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+InputStage<SampleType>::InputStage (State& stateToUse) : state (stateToUse)
+{
+}
+
+template <typename SampleType>
+void InputStage<SampleType>::process (const AudioBuffer& stereoInput, AudioBuffer& monoOutput)
+{
+	const auto numSamples  = stereoInput.getNumSamples();
+	const auto lastChannel = stereoInput.getNumChannels() - 1;
+
+	jassert (lastChannel >= 0 && monoOutput.getNumSamples() >= numSamples);
+
+	// 1 = left, 2 = right, 3 = mix to mono; reading the same channel twice at half weight covers all three in one loop
+	const auto mode = parameters.inputMode->get();
+
+	const auto* left  = stereoInput.getReadPointer (mode == 2 ? std::min (1, lastChannel) : 0);
+	const auto* right = stereoInput.getReadPointer (mode == 1 ? 0 : std::min (1, lastChannel));
+
+	auto* output = monoOutput.getWritePointer (0);
+
+	const auto targetGain = static_cast<SampleType> (juce::Decibels::decibelsToGain (parameters.inputGain->get()));
+	const auto gainStep	  = numSamples > 0 ? (targetGain - lastGain) / static_cast<SampleType> (numSamples) : SampleType (0);
+
+	const auto gateIsOn		 = parameters.noiseGateToggle->get();
+	const auto gateThreshold = static_cast<SampleType> (juce::Decibels::decibelsToGain (parameters.noiseGateThresh->get()));
+	const auto thresholdSq	 = gateThreshold * gateThreshold;
+	const auto floorGain	 = gateIsOn ? static_cast<SampleType> (1. / gateFloorRatio) : SampleType (1);
+
+	auto s1 = filterState1, s2 = filterState2;
+	auto gain = lastGain, envelope = gateEnvelope, gate = gateGain;
+
+	SampleType sumOfSquares { 0 }, sumOfGateGains { 0 };
+
+	for (auto i = 0; i < numSamples; ++i)
+	{
+		const auto in = (left[i] + right[i]) * SampleType (0.5);
+
+		const auto filtered = b0 * in + s1;
+		s1					= b1 * in - a1 * filtered + s2;
+		s2					= b2 * in - a2 * filtered;
+
+		gain += gainStep;
+
+		const auto gained = filtered * gain;
+		const auto squared = gained * gained;
+
+		sumOfSquares += squared;
+
+		envelope += gateSensing * (squared - envelope);
+
+		const auto target = envelope >= thresholdSq ? SampleType (1) : floorGain;
+		gate += (target > gate ? gateAttack : gateRelease) * (target - gate);
+
+		sumOfGateGains += gate;
+
+		output[i] = gained * gate;
+	}
+
+	filterState1 = s1;
+	filterState2 = s2;
+	lastGain	 = targetGain;
+	gateEnvelope = envelope;
+	gateGain	 = gate;
+
+	if (numSamples == 0)
+		return;
+
+	level = std::sqrt (sumOfSquares / static_cast<SampleType> (numSamples));
+
+	if (gateIsOn)
+		meters.readings.gateRedux = juce::Decibels::gainToDecibels (static_cast<float> (sumOfGateGains / static_cast<SampleType> (numSamples)));
+	else
+		meters.readings.gateRedux = 0.f;
+}
+
+template <typename SampleType>
+void InputStage<SampleType>::prepare (double samplerate, int)
+{
+	jassert (samplerate > 0.);
+
+	// RBJ Butterworth high-pass (Q = 1/sqrt2), normalised by a0
+	const auto omega = juce::MathConstants<double>::twoPi * loCutFrequency / samplerate;
+	const auto alpha = std::sin (omega) / juce::MathConstants<double>::sqrt2;
+	const auto cosw	 = std::cos (omega);
+	const auto a0	 = 1. + alpha;
+
+	b0 = static_cast<SampleType> ((1. + cosw) * 0.5 / a0);
+	b1 = static_cast<SampleType> (-(1. + cosw) / a0);
+	b2 = b0;
+	a1 = static_cast<SampleType> (-2. * cosw / a0);
+	a2 = static_cast<SampleType> ((1. - alpha) / a0);
+
+	const auto toCoefficient = [samplerate] (double ms)
+	{ return static_cast<SampleType> (1. - std::exp (-1000. / (ms * samplerate))); };
+
+	gateAttack	= toCoefficient (gateAttackMs);
+	gateRelease = toCoefficient (gateReleaseMs);
+	gateSensing = toCoefficient (gateSensingMs);
+
+	filterState1 = filterState2 = gateEnvelope = SampleType (0);
+
+	gateGain = SampleType (1);
+	lastGain = static_cast<SampleType> (juce::Decibels::decibelsToGain (parameters.inputGain->get()));
+}
+
+template struct InputStage<float>;
+template struct InputStage<double>;
+
+}  // namespace Imogen
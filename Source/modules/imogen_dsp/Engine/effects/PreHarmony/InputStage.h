@@ -0,0 +1,46 @@
+#pragma once
+
+namespace Imogen
+{
+/*
+	The whole input conditioning chain as a single pass over the block: stereo reduction, the fixed 65 Hz high-pass,
+	the smoothed input gain, the input level and the noise gate all happen per sample in the same loop,
+	so the mono signal is written once and never re-read before the analyzer sees it.
+*/
+template <typename SampleType>
+struct InputStage
+{
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	InputStage (State& stateToUse);
+
+	void process (const AudioBuffer& stereoInput, AudioBuffer& monoOutput);
+
+	void prepare (double samplerate, int blocksize);
+
+	SampleType getLevel() const noexcept { return level; }
+
+private:
+
+	State&		state;
+	Parameters& parameters { state.parameters };
+	Meters&		meters { state.meters };
+
+	static constexpr auto loCutFrequency = 65.;
+	static constexpr auto gateAttackMs	 = 25.;
+	static constexpr auto gateReleaseMs	 = 100.;
+	static constexpr auto gateSensingMs	 = 10.;
+	static constexpr auto gateFloorRatio = 10.;	 // ratio to one when the noise gate is closed
+
+	SampleType b0 { 1 }, b1 { 0 }, b2 { 0 }, a1 { 0 }, a2 { 0 };
+	SampleType filterState1 { 0 }, filterState2 { 0 };
+
+	SampleType lastGain { 1 };
+
+	SampleType gateAttack { 0 }, gateRelease { 0 }, gateSensing { 0 };
+	SampleType gateEnvelope { 0 }, gateGain { 1 };
+
+	SampleType level { 0 };
+};
+
+}  // namespace Imogen
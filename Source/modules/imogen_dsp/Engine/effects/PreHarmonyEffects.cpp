@@ -2,29 +2,23 @@
 namespace Imogen
 {
 template <typename SampleType>
-PreHarmonyEffects<SampleType>::PreHarmonyEffects (State& stateToUse)
-	: state (stateToUse)
+PreHarmonyEffects<SampleType>::PreHarmonyEffects (State& stateToUse, AudioArena<SampleType>& arenaToUse)
+	: state (stateToUse), arena (arenaToUse)
 {
 }
 
 template <typename SampleType>
 void PreHarmonyEffects<SampleType>::prepare (double samplerate, int blocksize)
 {
-	processedMonoBuffer.setSize (1, blocksize, true, true, true);
+	arena.claim (processedMonoBuffer, 1, blocksize);
 
-	stereoReducer.prepare (samplerate, blocksize);
-	initialLoCut.prepare (samplerate, blocksize);
-	inputGain.prepare (samplerate, blocksize);
-	gate.prepare (samplerate, blocksize);
+	inputStage.prepare (samplerate, blocksize);
 }
 
 template <typename SampleType>
 void PreHarmonyEffects<SampleType>::process (const AudioBuffer& input)
 {
-	stereoReducer.process (input, processedMonoBuffer);
-	initialLoCut.process (processedMonoBuffer);
-	inputGain.process (processedMonoBuffer);
-	gate.process (processedMonoBuffer);
+	inputStage.process (input, processedMonoBuffer);
 }
 
 template <typename SampleType>
@@ -33,6 +27,12 @@ const SampleType* PreHarmonyEffects<SampleType>::getProcessedInputSignal() const
 	return processedMonoBuffer.getReadPointer (0);
 }
 
+template <typename SampleType>
+SampleType PreHarmonyEffects<SampleType>::getInputLevel() const noexcept
+{
+	return inputStage.getLevel();
+}
+
 template class PreHarmonyEffects<float>;
 template class PreHarmonyEffects<double>;
 
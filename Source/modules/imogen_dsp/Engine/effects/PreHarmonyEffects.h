@@ -1,5 +1,7 @@
 #pragma once
 
+#include <imogen_dsp/Engine/Utils/AudioArena.h>
+
 namespace Imogen
 {
 template <typename SampleType>
@@ -9,7 +11,7 @@ public:
 
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 
-	PreHarmonyEffects (State& stateToUse);
+	PreHarmonyEffects (State& stateToUse, AudioArena<SampleType>& arenaToUse);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -17,16 +19,18 @@ public:
 
 	const SampleType* getProcessedInputSignal() const;
 
+	SampleType getInputLevel() const noexcept;
+
+	static constexpr int numArenaChannels = 1;
+
 private:
 
 	AudioBuffer processedMonoBuffer;
 
-	State& state;
+	State&					state;
+	AudioArena<SampleType>& arena;
 
-	StereoReducer<SampleType>	stereoReducer { state.parameters };
-	dsp::FX::Filter<SampleType> initialLoCut { dsp::FX::FilterType::HighPass, 65.f };
-	InputGain<SampleType>		inputGain { state };
-	NoiseGate<SampleType>		gate { state };
+	InputStage<SampleType> inputStage { state };
 };
 
 }  // namespace Imogen
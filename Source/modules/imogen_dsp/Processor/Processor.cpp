@@ -9,6 +9,16 @@ Processor::Processor()
 {
 }
 
+Processor::~Processor()
+{
+	cancelPendingUpdate();
+}
+
+bool Processor::loadReverbImpulseResponse (const juce::File& file)
+{
+	return getState().impulseResponse.loadFromFile (file);
+}
+
 double Processor::getTailLengthSeconds() const
 {
 	return parameters.midiState.adsrRelease->get();
@@ -21,5 +31,19 @@ bool Processor::isBusesLayoutSupported (const BusesLayout& layouts) const
 	return layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
 }
 
+/*
+	Re-prepares the engine after a setting that changes its latency; preparing is what reports the new sample count to the host.
+	This runs on the message thread, and suspending takes the callback lock, so the engine is never re-prepared under a running block.
+*/
+void Processor::handleAsyncUpdate()
+{
+	if (getSampleRate() <= 0. || getBlockSize() <= 0)
+		return;
+
+	suspendProcessing (true);
+	prepareToPlay (getSampleRate(), getBlockSize());
+	suspendProcessing (false);
+}
+
 
 }  // namespace Imogen
@@ -6,11 +6,17 @@
 namespace Imogen
 {
 class Processor : public plugin::Processor<State, Engine>
+	, private juce::AsyncUpdater
 {
 public:
 
 	Processor();
 
+	~Processor() override;
+
+	/* Reads an audio file into the convolution reverb's impulse response. Returns false if it couldn't be read. */
+	bool loadReverbImpulseResponse (const juce::File& file);
+
 private:
 
 	bool canAddBus (bool isInput) const override final { return isInput; }
@@ -26,7 +32,17 @@ private:
 	const String	  getName() const final { return "Imogen"; }
 	juce::StringArray getAlternateDisplayNames() const final { return { "Imgn" }; }
 
+	void handleAsyncUpdate() final;
+
 	Parameters& parameters { getState().parameters };
+	Internals&	internals { getState().internals };
+
+	// these can fire on any thread, including the audio thread, so the re-prepare is always deferred to the message thread
+	plugin::ParamUpdater latencyModeUpdater { internals.latencyMode, [&]
+											  { triggerAsyncUpdate(); } };
+
+	plugin::ParamUpdater pipelineUpdater { internals.pipelinedRendering, [&]
+										   { triggerAsyncUpdate(); } };
 
 	// network::OscDataSynchronizer dataSync {state};
 };
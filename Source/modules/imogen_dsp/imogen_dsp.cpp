@@ -1,12 +1,20 @@
 
 #include "imogen_dsp.h"
 
+#include "Engine/Utils/RealtimeThread.cpp"
+#include "Engine/Utils/AudioArena.cpp"
+#include "Engine/Utils/RealtimeSentinel.cpp"
 
-#include "Engine/effects/PreHarmony/StereoReducer.cpp"
-#include "Engine/effects/PreHarmony/InputGain.cpp"
-#include "Engine/effects/PreHarmony/NoiseGate.cpp"
+#include "Engine/ParameterSnapshot.cpp"
+
+#include "Engine/Analysis/Decimator.cpp"
+#include "Engine/Analysis/PitchDetector.cpp"
+
+#include "Engine/effects/PreHarmony/InputStage.cpp"
 #include "Engine/effects/PreHarmonyEffects.cpp"
 
+#include "Engine/Harmonizer/VoiceRenderPool.cpp"
+#include "Engine/Harmonizer/VoiceBank.cpp"
 #include "Engine/Harmonizer/Harmonizer.cpp"
 #include "Engine/Harmonizer/HarmonizerVoice.cpp"
 
@@ -15,16 +23,25 @@
 #include "Engine/Lead/PitchCorrector.cpp"
 
 #include "Engine/effects/PostHarmony/EQ.cpp"
+#include "Engine/effects/PostHarmony/Dynamics.cpp"
 #include "Engine/effects/PostHarmony/Compressor.cpp"
 #include "Engine/effects/PostHarmony/DeEsser.cpp"
 #include "Engine/effects/PostHarmony/DryWetMixer.cpp"
+#include "Engine/effects/PostHarmony/TailSleep.cpp"
 #include "Engine/effects/PostHarmony/Delay.cpp"
+#include "Engine/effects/PostHarmony/ReverbMixer.cpp"
+#include "Engine/effects/PostHarmony/FdnReverb.cpp"
+#include "Engine/effects/PostHarmony/PartitionedConvolver.cpp"
+#include "Engine/effects/PostHarmony/ConvolutionReverb.cpp"
 #include "Engine/effects/PostHarmony/Reverb.cpp"
 #include "Engine/effects/PostHarmony/OutputGain.cpp"
 #include "Engine/effects/PostHarmony/Limiter.cpp"
 
 #include "Engine/effects/PostHarmonyEffects.cpp"
 
+#include "Engine/LoadGovernor.cpp"
+#include "Engine/Metering.cpp"
+#include "Engine/PipelineWorker.cpp"
 #include "Engine/Engine.cpp"
 
 #include "Processor/Processor.cpp"
@@ -10,10 +10,17 @@
  version:            0.0.1
  name:               imogen_dsp
  description:        DSP module for Imogen
- dependencies:       lemons_synth lemons_psola imogen_state
+ dependencies:       lemons_synth lemons_psola imogen_state juce_dsp
 
  END_JUCE_MODULE_DECLARATION
 
 -------------------------------------------------------------------------------------*/
 
+/** Config: IMOGEN_RT_SENTINEL
+	Debug builds only: reports heap allocations, mutex locks and sleeps made on the audio thread while the engine is rendering.
+ */
+#ifndef IMOGEN_RT_SENTINEL
+#	define IMOGEN_RT_SENTINEL 0
+#endif
+
 #include "Processor/Processor.h"
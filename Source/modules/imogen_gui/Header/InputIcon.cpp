@@ -4,14 +4,36 @@ namespace Imogen
 InputIcon::InputIcon (State& stateToUse)
 	: state (stateToUse)
 {
+	startTimerHz (30);
 }
 
-void InputIcon::paint (juce::Graphics&)
+void InputIcon::paint (juce::Graphics& g)
 {
+	const auto bounds = getLocalBounds().toFloat().reduced (1.f);
+
+	g.setColour (juce::Colours::darkgrey);
+	g.drawEllipse (bounds, 1.f);
+
+	// the circle fills out from the centre with the input's RMS, and turns red if the input clips
+	const auto size = std::min (bounds.getWidth(), bounds.getHeight()) * meterProportion (level.rms);
+
+	g.setColour (level.peak >= 1.f ? juce::Colours::red : juce::Colours::limegreen);
+	g.fillEllipse (juce::Rectangle<float> { size, size }.withCentre (bounds.getCentre()));
 }
 
 void InputIcon::resized()
 {
 }
 
+void InputIcon::timerCallback()
+{
+	if (const auto version = meters.getVersion(); version != lastVersion)
+	{
+		lastVersion = version;
+		level		= meters.read().input;
+
+		repaint();
+	}
+}
+
 }  // namespace Imogen
@@ -2,7 +2,11 @@
 
 namespace Imogen
 {
+/*
+	Shows the level arriving from the host, before the input gain and gate, polled from the meter snapshot.
+*/
 class InputIcon : public juce::Component
+	, private juce::Timer
 {
 public:
 
@@ -13,11 +17,16 @@ private:
 	void paint (juce::Graphics& g) final;
 	void resized() final;
 
+	void timerCallback() final;
+
 	State& state;
 
-	plugin::GainMeterParameter& inputMeter { *state.meters.inputLevel };
+	MeterSnapshot::Reader meters { state.meters.snapshot };
 
 	plugin::GainParameter& inputGain { *state.parameters.inputGain };
+
+	std::uint32_t		 lastVersion { 0 };
+	MeterReadings::Level level;
 };
 
 }  // namespace Imogen
@@ -2,8 +2,11 @@
 namespace Imogen
 {
 OutputLevelMeter::OutputLevelMeter (Meters& metersToUse)
-	: meters (metersToUse)
+	: meters (metersToUse.snapshot)
 {
+	gui::addAndMakeVisible (this, left, right);
+
+	startTimerHz (30);
 }
 
 void OutputLevelMeter::paint (juce::Graphics&)
@@ -12,21 +15,55 @@ void OutputLevelMeter::paint (juce::Graphics&)
 
 void OutputLevelMeter::resized()
 {
+	auto bounds = getLocalBounds();
+
+	left.setBounds (bounds.removeFromLeft (bounds.getWidth() / 2));
+	right.setBounds (bounds);
+}
+
+void OutputLevelMeter::timerCallback()
+{
+	if (const auto version = meters.getVersion(); version != lastVersion)
+	{
+		lastVersion = version;
+
+		const auto readings = meters.read();
+
+		left.setLevel (readings.outputL);
+		right.setLevel (readings.outputR);
+	}
 }
 
 
-OutputLevelMeter::Bar::Bar (plugin::GainMeterParameter& meter)
-	: level (meter)
+void OutputLevelMeter::Bar::setLevel (const MeterReadings::Level& newLevel)
 {
-	juce::ignoreUnused (level);
+	level = newLevel;
+	repaint();
 }
 
-void OutputLevelMeter::Bar::paint (juce::Graphics&)
+void OutputLevelMeter::Bar::paint (juce::Graphics& g)
 {
+	const auto bounds = getLocalBounds().toFloat();
+
+	g.setColour (juce::Colours::darkgrey);
+	g.fillRect (bounds);
+
+	g.setColour (level.truePeak >= 1.f ? juce::Colours::red : juce::Colours::limegreen);
+	g.fillRect (bounds.withTop (bounds.getBottom() - bounds.getHeight() * meterProportion (level.rms)));
+
+	// the peak as a line above the RMS bar
+	const auto peakY = bounds.getBottom() - bounds.getHeight() * meterProportion (level.peak);
+
+	g.setColour (juce::Colours::white);
+	g.drawHorizontalLine (juce::roundToInt (peakY), bounds.getX(), bounds.getRight());
 }
 
-void OutputLevelMeter::Bar::resized()
+
+float meterProportion (float gain) noexcept
 {
+	static constexpr auto floorDb = -60.f;
+
+	return juce::jmap (juce::Decibels::gainToDecibels (gain, floorDb), floorDb, 0.f, 0.f, 1.f);
 }
 
 }  // namespace Imogen
@@ -1,9 +1,12 @@
-
 #pragma once
 
 namespace Imogen
 {
+/*
+	Polls the meter snapshot from the message thread and repaints whenever the engine has published new readings.
+*/
 class OutputLevelMeter : public juce::Component
+	, private juce::Timer
 {
 public:
 
@@ -13,23 +16,28 @@ private:
 
 	struct Bar : juce::Component
 	{
-		Bar (plugin::GainMeterParameter& meter);
+		void setLevel (const MeterReadings::Level& newLevel);
 
 	private:
 
 		void paint (juce::Graphics& g) final;
-		void resized() final;
 
-		plugin::GainMeterParameter& level;
+		MeterReadings::Level level;
 	};
 
 	void paint (juce::Graphics& g) final;
 	void resized() final;
 
-	Meters& meters;
+	void timerCallback() final;
+
+	MeterSnapshot::Reader meters;
 
-	Bar left { *meters.outputLevelL };
-	Bar right { *meters.outputLevelR };
+	std::uint32_t lastVersion { 0 };
+
+	Bar left, right;
 };
 
+/* Maps a linear gain onto 0-1 across the meters' -60 to 0 dB range. */
+float meterProportion (float gain) noexcept;
+
 }  // namespace Imogen
@@ -1,3 +1,5 @@
 #include "imogen_state.h"
 
+#include "state/ImpulseResponse.cpp"
+#include "state/MeterSnapshot.cpp"
 #include "state/State.cpp"
@@ -10,7 +10,7 @@
  version:            0.0.1
  name:               imogen_state
  description:        Imogen's shared state
- dependencies:       lemons_plugin
+ dependencies:       lemons_plugin juce_audio_formats
 
  END_JUCE_MODULE_DECLARATION
 
@@ -18,6 +18,7 @@
 
 
 #include <lemons_plugin/lemons_plugin.h>
+#include <juce_audio_formats/juce_audio_formats.h>
 
 namespace Imogen
 {
@@ -0,0 +1,104 @@
+
+namespace Imogen
+{
+void ImpulseResponse::set (const juce::AudioBuffer<float>& newAudio, double newSamplerate)
+{
+	jassert (newSamplerate > 0.);
+
+	{
+		const std::lock_guard lock { mutex };
+
+		audio	   = newAudio;
+		samplerate = newSamplerate;
+	}
+
+	version.fetch_add (1, std::memory_order_release);
+}
+
+bool ImpulseResponse::loadFromFile (const juce::File& file)
+{
+	juce::AudioFormatManager formats;
+	formats.registerBasicFormats();
+
+	const std::unique_ptr<juce::AudioFormatReader> reader { formats.createReaderFor (file) };
+
+	if (reader == nullptr || reader->sampleRate <= 0. || reader->lengthInSamples <= 0)
+		return false;
+
+	const auto numChannels = static_cast<int> (std::min (reader->numChannels, 2u));
+	const auto numSamples  = static_cast<int> (std::min (reader->lengthInSamples,
+														 static_cast<juce::int64> (reader->sampleRate * maxLengthSeconds)));
+
+	juce::AudioBuffer<float> newAudio { numChannels, numSamples };
+
+	if (! reader->read (&newAudio, 0, numSamples, 0, true, numChannels > 1))
+		return false;
+
+	set (newAudio, reader->sampleRate);
+	return true;
+}
+
+void ImpulseResponse::clear()
+{
+	{
+		const std::lock_guard lock { mutex };
+
+		audio.setSize (0, 0);
+		samplerate = 0.;
+	}
+
+	version.fetch_add (1, std::memory_order_release);
+}
+
+bool ImpulseResponse::read (juce::AudioBuffer<float>& destination, double& destinationSamplerate) const
+{
+	const std::lock_guard lock { mutex };
+
+	if (audio.getNumSamples() == 0)
+		return false;
+
+	destination			  = audio;
+	destinationSamplerate = samplerate;
+
+	return true;
+}
+
+juce::MemoryBlock ImpulseResponse::toMemory (int& numChannels, double& sourceSamplerate) const
+{
+	const std::lock_guard lock { mutex };
+
+	numChannels		 = audio.getNumChannels();
+	sourceSamplerate = samplerate;
+
+	const auto channelBytes = sizeof (float) * static_cast<size_t> (audio.getNumSamples());
+
+	juce::MemoryBlock data { channelBytes * static_cast<size_t> (numChannels) };
+
+	for (auto chan = 0; chan < numChannels; ++chan)
+		data.copyFrom (audio.getReadPointer (chan), static_cast<int> (channelBytes * static_cast<size_t> (chan)), channelBytes);
+
+	return data;
+}
+
+void ImpulseResponse::restoreFromMemory (const juce::MemoryBlock& data, int numChannels, double sourceSamplerate)
+{
+	const auto frameBytes = sizeof (float) * static_cast<size_t> (std::max (numChannels, 1));
+
+	if (data.isEmpty() || numChannels < 1 || numChannels > 2 || sourceSamplerate <= 0. || data.getSize() % frameBytes != 0)
+	{
+		clear();
+		return;
+	}
+
+	const auto numSamples = static_cast<int> (data.getSize() / frameBytes);
+
+	juce::AudioBuffer<float> newAudio { numChannels, numSamples };
+
+	for (auto chan = 0; chan < numChannels; ++chan)
+		data.copyTo (newAudio.getWritePointer (chan), static_cast<int> (sizeof (float) * static_cast<size_t> (chan * numSamples)),
+					 sizeof (float) * static_cast<size_t> (numSamples));
+
+	set (newAudio, sourceSamplerate);
+}
+
+}  // namespace Imogen
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <mutex>
+
+namespace Imogen
+{
+/*
+	The impulse response used by the convolution reverb.
+	Any thread except the audio thread can replace it. The audio thread only ever checks getVersion(); when that changes, it wakes
+	the reverb's background thread, which copies the audio out with read() to transform it. It's saved with the plugin's state.
+*/
+class ImpulseResponse
+{
+public:
+
+	void set (const juce::AudioBuffer<float>& newAudio, double newSamplerate);
+
+	/* Returns false if the file couldn't be read as audio. */
+	bool loadFromFile (const juce::File& file);
+
+	void clear();
+
+	int getVersion() const noexcept { return version.load (std::memory_order_acquire); }
+
+	/* Copies the current impulse response out. Returns false if there isn't one. */
+	bool read (juce::AudioBuffer<float>& destination, double& destinationSamplerate) const;
+
+	/* The samples, channel after channel, for storing in the plugin state. Empty if there's no impulse response. */
+	juce::MemoryBlock toMemory (int& numChannels, double& sourceSamplerate) const;
+
+	/* Replaces the impulse response with one stored by toMemory(), or clears it if the data is empty or doesn't fit. */
+	void restoreFromMemory (const juce::MemoryBlock& data, int numChannels, double sourceSamplerate);
+
+	static constexpr double maxLengthSeconds = 10.;
+
+private:
+
+	mutable std::mutex mutex;
+
+	juce::AudioBuffer<float> audio;
+	double					 samplerate { 0. };
+
+	std::atomic<int> version { 0 };
+};
+
+}  // namespace Imogen
@@ -23,6 +23,39 @@ struct Internals
 
 	BoolParam guiDarkMode { true, "GUI Dark mode" };
 
+	ToggleParam parallelVoiceRendering { "Parallel voice rendering", false };
+	ToggleParam pipelinedRendering { "Pipelined rendering", false };
+	ToggleParam fftPitchDetection { "FFT pitch detection", false };
+
+	IntParam latencyMode { 1, 2, 2, "Latency mode",
+						   [] (int value, int maxLength)
+						   {
+							   if (value == 1) return TRANS ("Live").substring (0, maxLength);
+							   return TRANS ("Studio").substring (0, maxLength);
+						   },
+						   [] (const juce::String& text)
+						   {
+							   if (text.containsIgnoreCase (TRANS ("Live"))) return 1;
+							   return 2;
+						   } };
+
+	IntParam voiceCapacity { 4, 64, 16, "Voice capacity" };
+
+	ToggleParam lockAudioMemory { "Lock audio memory", false };
+
+	IntParam arenaFootprintKb { 0, 1000000, 0, "Arena and voice bank memory (KB)" };
+
+	IntParam loadSheddingLevel { 0, 8, 0, "Load shedding level" };
+
+	IntParam loadSheddingEvents { 0, 1000000, 0, "Load shedding events" };
+
+	IntParam reverbSleepState { 0, 2, 0, "Reverb sleep state", sleepStateToString };
+	IntParam delaySleepState { 0, 2, 0, "Delay sleep state", sleepStateToString };
+
+	ToggleParam hostMetering { "Host metering", false };
+
+	IntParam convolutionMissedDeadlines { 0, 1000000, 0, "Convolution reverb missed deadlines" };
+
 	IntParam currentInputNote { -1, 127, -1, "Current input note",
 								[] (int note, int maxLength)
 								{
@@ -44,6 +77,8 @@ struct Internals
 
 private:
 
+	static juce::String sleepStateToString (int sleepState, int maxLength);
+
 	plugin::ParamUpdater linkPeersUpdater { abletonLinkEnabled, [&]
 											{
 												if (! abletonLinkEnabled->get())
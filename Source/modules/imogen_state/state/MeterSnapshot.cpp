@@ -0,0 +1,77 @@
+
+namespace Imogen
+{
+MeterSnapshot::MeterSnapshot()
+{
+	const MeterReadings initial;
+
+	float values[numValues];
+	std::memcpy (values, &initial, sizeof (initial));
+
+	for (auto& slot : slots)
+		for (auto i = 0; i < numValues; ++i)
+			slot.values[i].store (values[i], std::memory_order_relaxed);
+}
+
+void MeterSnapshot::publish (const MeterReadings& readings) noexcept
+{
+	float values[numValues];
+	std::memcpy (values, &readings, sizeof (readings));
+
+	const auto version = latest.load (std::memory_order_relaxed) + 1;
+
+	auto& slot = slots[version % numSlots];
+
+	// an odd sequence number marks the slot as being written
+	slot.sequence.store (version * 2 - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+
+	for (auto i = 0; i < numValues; ++i)
+		slot.values[i].store (values[i], std::memory_order_relaxed);
+
+	slot.sequence.store (version * 2, std::memory_order_release);
+	latest.store (version, std::memory_order_release);
+}
+
+MeterReadings MeterSnapshot::read() const noexcept
+{
+	float values[numValues];
+
+	while (true)
+	{
+		const auto version = latest.load (std::memory_order_acquire);
+
+		const auto& slot = slots[version % numSlots];
+
+		const auto before = slot.sequence.load (std::memory_order_acquire);
+
+		if (before != version * 2)
+			continue;
+
+		for (auto i = 0; i < numValues; ++i)
+			values[i] = slot.values[i].load (std::memory_order_relaxed);
+
+		std::atomic_thread_fence (std::memory_order_acquire);
+
+		if (slot.sequence.load (std::memory_order_relaxed) == before)
+			break;
+	}
+
+	MeterReadings readings;
+	std::memcpy (&readings, values, sizeof (readings));
+	return readings;
+}
+
+
+MeterSnapshot::Reader::Reader (MeterSnapshot& snapshotToUse) noexcept
+	: snapshot (snapshotToUse)
+{
+	snapshot.numReaders.fetch_add (1, std::memory_order_relaxed);
+}
+
+MeterSnapshot::Reader::~Reader()
+{
+	snapshot.numReaders.fetch_sub (1, std::memory_order_relaxed);
+}
+
+}  // namespace Imogen
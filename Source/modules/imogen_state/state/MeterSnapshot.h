@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace Imogen
+{
+/*
+	Every meter the engine reports as of the latest chunk. Levels are linear gain; gain reductions and the reverb/delay levels are in dB.
+	Peaks are held for a moment and then released, and the RMS is integrated over a few hundred milliseconds, so they cover
+	the chunks before the latest one too.
+*/
+struct MeterReadings
+{
+	struct Level
+	{
+		float rms { 0.f }, peak { 0.f }, truePeak { 0.f };
+	};
+
+	Level input, outputL, outputR;
+
+	float gateRedux { 0.f }, compRedux { 0.f }, deEssRedux { 0.f }, limRedux { 0.f };
+
+	float reverbLevel { -60.f }, delayLevel { -60.f };
+};
+
+
+/*
+	The latest MeterReadings, published by the audio thread once per chunk while anyone is reading, and read by the editor and remote clients at
+	whatever rate they like. Publishing is wait-free and never blocks on a reader. Each publish goes into the next slot
+	of a small ring guarded by its own sequence number, so a read only has to retry if the writer has lapped the whole
+	ring while it was copying.
+*/
+class MeterSnapshot
+{
+public:
+
+	MeterSnapshot();
+
+	/* Audio thread only. */
+	void publish (const MeterReadings& readings) noexcept;
+
+	/* Any thread. */
+	[[nodiscard]] MeterReadings read() const noexcept;
+
+	/* Goes up by one with every publish, so a reader can tell whether anything has changed since it last looked. */
+	std::uint32_t getVersion() const noexcept { return latest.load (std::memory_order_acquire); }
+
+	/* Whether any Reader currently exists. The engine skips metering altogether while nobody is reading. */
+	bool hasReaders() const noexcept { return numReaders.load (std::memory_order_relaxed) > 0; }
+
+	/* Registers whoever holds it as a reader for as long as it exists. */
+	class Reader
+	{
+	public:
+
+		explicit Reader (MeterSnapshot& snapshotToUse) noexcept;
+		~Reader();
+
+		Reader (const Reader&)			  = delete;
+		Reader& operator= (const Reader&) = delete;
+
+		[[nodiscard]] MeterReadings read() const noexcept { return snapshot.read(); }
+
+		std::uint32_t getVersion() const noexcept { return snapshot.getVersion(); }
+
+	private:
+
+		MeterSnapshot& snapshot;
+	};
+
+private:
+
+	static constexpr int numValues = static_cast<int> (sizeof (MeterReadings) / sizeof (float));
+	static constexpr int numSlots  = 4;
+
+	static_assert (sizeof (MeterReadings) == numValues * sizeof (float));
+
+	struct alignas (64) Slot
+	{
+		std::atomic<std::uint32_t> sequence { 0 };
+		std::atomic<float>		   values[numValues];
+	};
+
+	Slot slots[numSlots];
+
+	alignas (64) std::atomic<std::uint32_t> latest { 0 };
+
+	std::atomic<int> numReaders { 0 };
+};
+
+}  // namespace Imogen
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "MeterSnapshot.h"
 
 namespace Imogen
 {
@@ -8,6 +9,16 @@ struct Meters
 {
 	void addToList (plugin::ParameterList& list);
 
+	/* Pushes the readings to the snapshot, and to the host's meter parameters too if notifyHost is true. */
+	void publish (bool notifyHost);
+
+	/* Filled in by the engine as it renders each chunk. Only the audio thread touches this. */
+	MeterReadings readings;
+
+	/* What the editor and remote clients read. */
+	MeterSnapshot snapshot;
+
+	/* The host's meter parameters. These are only updated while the host metering internal is switched on. */
 	GainMeter inputLevel { "Input level", inputMeter };
 
 	GainMeter outputLevelL { "Output level (L)", outputMeter };
@@ -1,8 +1,23 @@
 
 namespace Imogen
 {
-void CustomStateData::serialize (TreeReflector&)
+void CustomStateData::serialize (TreeReflector& ref)
 {
+	// stored as raw samples, so a session recalls the impulse response even if its file has moved
+	auto numChannels = 0;
+	auto samplerate	 = 0.;
+
+	juce::MemoryBlock samples;
+
+	if (ref.isSaving())
+		samples = impulseResponse.toMemory (numChannels, samplerate);
+
+	ref.add ("ImpulseResponse", samples);
+	ref.add ("ImpulseResponseChannels", numChannels);
+	ref.add ("ImpulseResponseSamplerate", samplerate);
+
+	if (ref.isLoading())
+		impulseResponse.restoreFromMemory (samples, numChannels, samplerate);
 }
 
 State::State() : plugin::CustomState<Parameters, CustomStateData> ("Imogen")
@@ -23,12 +38,40 @@ void Meters::addToList (plugin::ParameterList& list)
 	list.add (inputLevel, outputLevelL, outputLevelR, gateRedux, compRedux, deEssRedux, limRedux, reverbLevel, delayLevel);
 }
 
+void Meters::publish (bool notifyHost)
+{
+	snapshot.publish (readings);
+
+	if (! notifyHost)
+		return;
+
+	inputLevel->set (readings.input.rms);
+	outputLevelL->set (readings.outputL.rms);
+	outputLevelR->set (readings.outputR.rms);
+	gateRedux->set (readings.gateRedux);
+	compRedux->set (readings.compRedux);
+	deEssRedux->set (readings.deEssRedux);
+	limRedux->set (readings.limRedux);
+	reverbLevel->set (readings.reverbLevel);
+	delayLevel->set (readings.delayLevel);
+}
+
 void Internals::addToList (plugin::ParameterList& list)
 {
-	list.addInternal (abletonLinkEnabled, abletonLinkSessionPeers, mtsEspIsConnected, lastMovedMidiController, lastMovedCCValue, guiDarkMode, currentInputNote, currentCentsSharp);
+	list.addInternal (abletonLinkEnabled, abletonLinkSessionPeers, mtsEspIsConnected, lastMovedMidiController, lastMovedCCValue, guiDarkMode, parallelVoiceRendering, pipelinedRendering, fftPitchDetection, latencyMode, voiceCapacity, lockAudioMemory, arenaFootprintKb, loadSheddingLevel, loadSheddingEvents, reverbSleepState, delaySleepState, hostMetering, convolutionMissedDeadlines, currentInputNote, currentCentsSharp);
 	// mtsEspScaleName
 }
 
+juce::String Internals::sleepStateToString (int sleepState, int maxLength)
+{
+	switch (sleepState)
+	{
+		case (1) : return TRANS ("Ringing out").substring (0, maxLength);
+		case (2) : return TRANS ("Asleep").substring (0, maxLength);
+		default : return TRANS ("Awake").substring (0, maxLength);
+	}
+}
+
 
 EQState::EQState (plugin::ParameterList& list)
 {
@@ -38,7 +81,7 @@ EQState::EQState (plugin::ParameterList& list)
 
 ReverbState::ReverbState (plugin::ParameterList& list)
 {
-	list.add (reverbToggle, reverbDryWet, reverbDecay, reverbDuck, reverbLoCut, reverbHiCut);
+	list.add (reverbToggle, reverbDryWet, reverbDecay, reverbDuck, reverbLoCut, reverbHiCut, reverbEngine);
 }
 
 
@@ -3,12 +3,16 @@
 #include "Parameters.h"
 #include "Meters.h"
 #include "Internals.h"
+#include "ImpulseResponse.h"
 
 
 namespace Imogen
 {
+/* The parts of Imogen's state that aren't parameters. */
 struct CustomStateData : SerializableData
 {
+	ImpulseResponse impulseResponse;
+
 private:
 
 	void serialize (TreeReflector& ref) final;
@@ -21,6 +25,8 @@ struct State : plugin::CustomState<Parameters, CustomStateData>
 
 	Internals internals;
 	Meters	  meters;
+
+	ImpulseResponse& impulseResponse { customData.impulseResponse };
 };
 
 }  // namespace Imogen
@@ -12,6 +12,23 @@ struct ReverbState
 	PercentParam reverbDuck { "Reverb duck", 30 };
 	HzParam		 reverbLoCut { "Reverb lo cut", 80.f };
 	HzParam		 reverbHiCut { "Reverb hi cut", 5500.f };
+
+	IntParam reverbEngine { 1, 3, 1, "Reverb engine",
+							[] (int value, int maxLength)
+							{
+								switch (value)
+								{
+									case (2) : return TRANS ("Delay network").substring (0, maxLength);
+									case (3) : return TRANS ("Convolution").substring (0, maxLength);
+									default : return TRANS ("Classic").substring (0, maxLength);
+								}
+							},
+							[] (const juce::String& text)
+							{
+								if (text.containsIgnoreCase (TRANS ("network"))) return 2;
+								if (text.containsIgnoreCase (TRANS ("Convolution"))) return 3;
+								return 1;
+							} };
 };
 
 }  // namespace Imogen
@@ -0,0 +1,127 @@
+/*
+	Measures what splitting blocks into automation slices costs the dry/wet mixer and the lead panner.
+	Each runs with its parameter still, moved on one block in a hundred, and moved on every block,
+	and the moving cases are reported against the still one, which never splits its block.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+namespace Imogen::Tests
+{
+enum class Automation
+{
+	still,
+	sparse,
+	dense
+};
+
+static bool movesOnBlock (Automation automation, int block)
+{
+	switch (automation)
+	{
+		case Automation::still : return false;
+		case Automation::sparse : return block % 100 == 0;
+		case Automation::dense : return true;
+	}
+
+	return false;
+}
+
+/* Sweeps back and forth across most of the range, so every move is a large one. */
+static int automatedValue (int block, int minimum, int maximum)
+{
+	const auto range = maximum - minimum;
+	const auto step	 = (block / 4) % (2 * range);
+
+	return minimum + (step < range ? step : 2 * range - step);
+}
+
+template <typename SampleType>
+static double timeMixer (State& state, int blocksize, Automation automation)
+{
+	static constexpr auto numBlocks = 2000;
+
+	DryWetMixer<SampleType> mixer { state.parameters };
+	mixer.prepare (48000., blocksize);
+
+	juce::AudioBuffer<SampleType> dry { 2, blocksize }, wet { 2, blocksize };
+
+	auto block	= 0;
+	auto wetMix = 50;
+
+	return microsecondsPerCall (numBlocks, [&]
+								{
+									if (movesOnBlock (automation, ++block))
+										wetMix = automatedValue (block, 10, 90);
+
+									dry.clear();
+									wet.clear();
+
+									mixer.process (dry, wet, wetMix);
+									doNotOptimise (dry);
+								});
+}
+
+template <typename SampleType>
+static double timePanner (State& state, int blocksize, Automation automation)
+{
+	static constexpr auto numBlocks = 2000;
+
+	DryPanner<SampleType> panner { state.parameters };
+	panner.prepare (48000., blocksize);
+
+	juce::AudioBuffer<SampleType> mono { 1, blocksize }, stereo { 2, blocksize };
+	mono.clear();
+
+	auto block = 0;
+
+	return microsecondsPerCall (numBlocks, [&]
+								{
+									if (movesOnBlock (automation, ++block))
+										state.parameters.leadPan->set (automatedValue (block, 10, 117));
+
+									panner.process (mono, stereo, false);
+									doNotOptimise (stereo);
+								});
+}
+
+template <typename SampleType>
+static void runScenarios (const char* typeName, int blocksize)
+{
+	State state;
+
+	const double mixerTimes[] { timeMixer<SampleType> (state, blocksize, Automation::still),
+								timeMixer<SampleType> (state, blocksize, Automation::sparse),
+								timeMixer<SampleType> (state, blocksize, Automation::dense) };
+
+	const double pannerTimes[] { timePanner<SampleType> (state, blocksize, Automation::still),
+								 timePanner<SampleType> (state, blocksize, Automation::sparse),
+								 timePanner<SampleType> (state, blocksize, Automation::dense) };
+
+	std::printf ("  %-6s  %4d   mixer %6.2f / %6.2f (%4.2fx) / %6.2f (%4.2fx) us   panner %6.2f / %6.2f (%4.2fx) / %6.2f (%4.2fx) us\n",
+				 typeName, blocksize,
+				 mixerTimes[0], mixerTimes[1], mixerTimes[1] / mixerTimes[0], mixerTimes[2], mixerTimes[2] / mixerTimes[0],
+				 pannerTimes[0], pannerTimes[1], pannerTimes[1] / pannerTimes[0], pannerTimes[2], pannerTimes[2] / pannerTimes[0]);
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	std::printf ("Time per block: still / moving on 1 block in 100 / moving on every block\n");
+
+	for (const auto blocksize : { 256, 512, 1024 })
+	{
+		runScenarios<float> ("float", blocksize);
+		runScenarios<double> ("double", blocksize);
+	}
+
+	return 0;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#if defined(__linux__)
+#	include <unistd.h>
+#endif
+
+namespace Imogen::Tests
+{
+/* Runs the function a few times to warm the caches, then returns the median time of one call in microseconds. */
+template <typename Function>
+double microsecondsPerCall (int numCalls, Function&& function)
+{
+	using Clock = std::chrono::steady_clock;
+
+	for (auto i = 0; i < std::max (numCalls / 10, 1); ++i)
+		function();
+
+	std::vector<double> times;
+	times.reserve (static_cast<size_t> (numCalls));
+
+	for (auto i = 0; i < numCalls; ++i)
+	{
+		const auto start = Clock::now();
+		function();
+		times.push_back (std::chrono::duration<double, std::micro> (Clock::now() - start).count());
+	}
+
+	std::nth_element (times.begin(), times.begin() + numCalls / 2, times.end());
+	return times[static_cast<size_t> (numCalls / 2)];
+}
+
+/* The process's resident memory, from /proc on Linux. Returns -1 where that isn't available. */
+inline long residentMemoryKb()
+{
+#if defined(__linux__)
+	std::ifstream statm { "/proc/self/statm" };
+
+	long totalPages = 0, residentPages = 0;
+
+	if (statm >> totalPages >> residentPages)
+		return residentPages * (sysconf (_SC_PAGESIZE) / 1024);
+#endif
+
+	return -1;
+}
+
+/* Keeps the optimiser from throwing away a result that is otherwise unused. */
+template <typename T>
+void doNotOptimise (const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile ("" : : "g"(&value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
+
+}  // namespace Imogen::Tests
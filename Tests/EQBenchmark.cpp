@@ -0,0 +1,153 @@
+/*
+	Compares the shared four-lane EQ cascade with the two dsp::FX::EQ objects it replaced, for float and double,
+	both with steady settings and with every band's settings moving every block.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+#include <random>
+
+namespace Imogen::Tests
+{
+/* The previous implementation: one dsp::FX::EQ per signal path, each configured separately. */
+template <typename SampleType>
+struct TwoObjectEQ
+{
+	using FT = dsp::FX::FilterType;
+
+	TwoObjectEQ()
+	{
+		for (auto* eq : { &dryEQ, &wetEQ })
+		{
+			eq->addBand (FT::LowShelf, 80.f);
+			eq->addBand (FT::HighShelf, 10000.f);
+			eq->addBand (FT::HighPass, 80.f);
+			eq->addBand (FT::Peak, 2500.f);
+		}
+	}
+
+	void prepare (double samplerate, int blocksize)
+	{
+		dryEQ.prepare (samplerate, blocksize);
+		wetEQ.prepare (samplerate, blocksize);
+	}
+
+	void update (const ParameterSnapshot& snapshot)
+	{
+		for (auto* eq : { &dryEQ, &wetEQ })
+		{
+			setBand (*eq, FT::LowShelf, snapshot.lowShelf, true);
+			setBand (*eq, FT::HighShelf, snapshot.highShelf, true);
+			setBand (*eq, FT::Peak, snapshot.peak, true);
+			setBand (*eq, FT::HighPass, snapshot.highPass, false);
+		}
+	}
+
+	void process (juce::AudioBuffer<SampleType>& dry, juce::AudioBuffer<SampleType>& wet)
+	{
+		dryEQ.process (dry);
+		wetEQ.process (wet);
+	}
+
+private:
+
+	static void setBand (dsp::FX::EQ<SampleType>& eq, FT type, const ParameterSnapshot::EqBand& settings, bool hasGain)
+	{
+		if (auto* band = eq.getBandOfType (type))
+		{
+			band->setFilterFrequency (settings.freq);
+			band->setQfactor (settings.q);
+
+			if (hasGain)
+				band->setGain (settings.gain);
+		}
+	}
+
+	dsp::FX::EQ<SampleType> dryEQ, wetEQ;
+};
+
+template <typename SampleType>
+static void fillWithNoise (juce::AudioBuffer<SampleType>& buffer, std::mt19937& rng)
+{
+	std::uniform_real_distribution<SampleType> noise { SampleType (-0.5), SampleType (0.5) };
+
+	for (auto chan = 0; chan < buffer.getNumChannels(); ++chan)
+		for (auto i = 0; i < buffer.getNumSamples(); ++i)
+			buffer.setSample (chan, i, noise (rng));
+}
+
+template <typename SampleType>
+static void runScenario (const char* typeName, State& state, int numSamples, bool settingsMove)
+{
+	static constexpr auto numCalls	 = 20000;
+	static constexpr auto samplerate = 48000.;
+
+	using Group = ParameterSnapshot::Group;
+
+	auto& eqState = state.parameters.eqState;
+
+	ParameterSnapshot snapshot;
+	snapshot.capture (state.parameters);
+
+	EQ<SampleType> cascade { eqState, snapshot };
+	cascade.prepare (samplerate, numSamples);
+
+	TwoObjectEQ<SampleType> twoObjects;
+	twoObjects.prepare (samplerate, numSamples);
+	twoObjects.update (snapshot);
+
+	std::mt19937				  rng { 7 };
+	juce::AudioBuffer<SampleType> dry { 2, numSamples }, wet { 2, numSamples };
+
+	fillWithNoise (dry, rng);
+	fillWithNoise (wet, rng);
+
+	const auto cascadeTime = microsecondsPerCall (numCalls, [&]
+												  {
+													  if (settingsMove)
+														  for (const auto group : { Group::eqLowShelf, Group::eqHighShelf, Group::eqPeak, Group::eqHighPass })
+															  snapshot.markDirty (group);
+
+													  cascade.process (dry, wet, true, true);
+													  doNotOptimise (dry);
+													  doNotOptimise (wet);
+												  });
+
+	const auto twoObjectTime = microsecondsPerCall (numCalls, [&]
+													{
+														if (settingsMove)
+															twoObjects.update (snapshot);
+
+														twoObjects.process (dry, wet);
+														doNotOptimise (dry);
+														doNotOptimise (wet);
+													});
+
+	std::printf ("  %-6s  %4d samples  %-8s   two objects %7.3f us   cascade %7.3f us   %4.2fx\n",
+				 typeName, numSamples, settingsMove ? "moving" : "steady", twoObjectTime, cascadeTime, twoObjectTime / cascadeTime);
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen;
+	using namespace Imogen::Tests;
+
+	State state;
+	state.parameters.eqState.eqToggle->set (true);
+
+	for (const auto settingsMove : { false, true })
+	{
+		for (const auto numSamples : { 32, 128, 512 })
+		{
+			runScenario<float> ("float", state, numSamples, settingsMove);
+			runScenario<double> ("double", state, numSamples, settingsMove);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+/*
+	Renders the same input and MIDI through two real harmonizers, one rendering its voices serially and one on the render pool,
+	and fails unless their outputs match sample for sample. The MIDI lands mid-block and includes releases, a pitch bend
+	and load shedding, so both modes split their blocks at the same events and make the same audibility and shedding decisions.
+*/
+
+#include "HarmonizerRig.h"
+
+#include <cstdio>
+
+namespace Imogen::Tests
+{
+/* Notes start and stop at odd positions inside blocks, and a whole chord is released so its voices go quiet and fall asleep. */
+static MidiBuffer midiForBlock (int block, int blocksize)
+{
+	MidiBuffer midi;
+
+	const auto at = [blocksize] (int position)
+	{ return position % blocksize; };
+
+	switch (block)
+	{
+		case 0 :
+			for (const auto note : { 48, 55, 60, 64 })
+				midi.addEvent (juce::MidiMessage::noteOn (1, note, 0.8f), 0);
+			break;
+
+		case 12 :
+			midi.addEvent (juce::MidiMessage::noteOn (1, 67, 0.6f), at (101));
+			midi.addEvent (juce::MidiMessage::pitchWheel (1, 10000), at (173));
+			break;
+
+		case 30 :
+			midi.addEvent (juce::MidiMessage::noteOff (1, 55), at (13));
+			midi.addEvent (juce::MidiMessage::noteOn (1, 71, 0.9f), at (13));
+			midi.addEvent (juce::MidiMessage::noteOff (1, 64), at (209));
+			break;
+
+		case 60 :
+			for (const auto note : { 48, 60, 67, 71 })
+				midi.addEvent (juce::MidiMessage::noteOff (1, note), at (note * 3));
+			midi.addEvent (juce::MidiMessage::pitchWheel (1, 8192), at (5));
+			break;
+
+		case 200 :
+			for (auto i = 0; i < 8; ++i)
+				midi.addEvent (juce::MidiMessage::noteOn (1, 50 + i * 3, 0.7f), at (i * 29));
+			break;
+
+		case 260 :
+			for (auto i = 0; i < 8; i += 2)
+				midi.addEvent (juce::MidiMessage::noteOff (1, 50 + i * 3), at (i * 17 + 3));
+			break;
+
+		default :
+			break;
+	}
+
+	return midi;
+}
+
+template <typename SampleType>
+static bool rendersIdentically (const char* typeName)
+{
+	static constexpr auto numBlocks = 400;
+
+	HarmonizerRig<SampleType> serial { false }, parallel { true };
+
+	// lets the parallel harmonizer create its render pool on the message thread
+	juce::MessageManager::getInstance()->runDispatchLoopUntil (50);
+
+	const auto blocksize = serial.blocksize;
+
+	auto mismatches = 0;
+	auto firstBlock = -1;
+	auto energy		= 0.;
+
+	for (auto block = 0; block < numBlocks; ++block)
+	{
+		// the governor's levels are exercised while the big chord is held
+		const auto loadSheddingLevel = block >= 220 && block < 240 ? 2 : (block >= 240 && block < 250 ? 1 : 0);
+
+		const auto& serialOut	= serial.process (midiForBlock (block, blocksize), loadSheddingLevel);
+		const auto& parallelOut = parallel.process (midiForBlock (block, blocksize), loadSheddingLevel);
+
+		for (auto chan = 0; chan < 2; ++chan)
+		{
+			for (auto s = 0; s < blocksize; ++s)
+			{
+				const auto expected = serialOut.getSample (chan, s);
+
+				energy += static_cast<double> (expected * expected);
+
+				if (parallelOut.getSample (chan, s) != expected)
+				{
+					if (mismatches++ == 0)
+						firstBlock = block;
+				}
+			}
+		}
+	}
+
+	const auto passed = mismatches == 0 && energy > 0.;
+
+	std::printf ("  %-6s  %d blocks of %d samples: %d mismatched samples", typeName, numBlocks, blocksize, mismatches);
+
+	if (firstBlock >= 0)
+		std::printf (", the first in block %d", firstBlock);
+
+	if (energy <= 0.)
+		std::printf (", but the harmonizer was silent");
+
+	std::printf ("\n");
+
+	return passed;
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	std::printf ("Serial against parallel voice rendering, %d physical CPUs\n", juce::SystemStats::getNumPhysicalCpus());
+
+	const auto floatPassed	= rendersIdentically<float> ("float");
+	const auto doublePassed = rendersIdentically<double> ("double");
+
+	return floatPassed && doublePassed ? 0 : 1;
+}
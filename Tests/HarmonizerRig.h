@@ -0,0 +1,111 @@
+#pragma once
+
+#include <imogen_dsp/imogen_dsp.h>
+
+namespace Imogen::Tests
+{
+/* Also exposes the synth's own render loop, which is how the harmonizer rendered its voices before the voice bank. */
+template <typename SampleType>
+struct TestHarmonizer : Harmonizer<SampleType>
+{
+	using Harmonizer<SampleType>::Harmonizer;
+	using dsp::LambdaSynth<SampleType>::renderVoices;
+};
+
+/*
+	A harmonizer on its own, prepared the way the engine prepares it and fed a synthetic sung vowel,
+	so its voices can be rendered without the rest of the processor.
+*/
+template <typename SampleType>
+struct HarmonizerRig
+{
+	explicit HarmonizerRig (bool renderInParallel)
+	{
+		state.internals.parallelVoiceRendering->set (renderInParallel);
+
+		// the engine runs the harmonizer in chunks as long as the analyzer's latency
+		analyzer.setMinInputFreq (60);
+		analyzer.prepare (samplerate, 512);
+
+		blocksize = analyzer.getLatencySamples();
+		analyzer.prepare (samplerate, blocksize);
+
+		arena.prepare (Harmonizer<SampleType>::numArenaChannels, blocksize, false);
+
+		harmonizer.initialize (state.internals.voiceCapacity->get(), samplerate, blocksize);
+		harmonizer.prepare (samplerate, blocksize);
+
+		snapshot.capture (state.parameters);
+
+		input.resize (static_cast<size_t> (blocksize));
+		baselineOutput.setSize (2, blocksize);
+	}
+
+	/* Renders the next block the way the engine does. */
+	const AudioBuffer<SampleType>& process (MidiBuffer midi, int loadSheddingLevel = 0)
+	{
+		analyzeNextInput();
+
+		harmonizer.setLoadSheddingLevel (loadSheddingLevel);
+		harmonizer.process (blocksize, midi, false, inputLevel, nullptr);
+
+		return harmonizer.getHarmonySignal();
+	}
+
+	/* Renders the next block through the synth's own render loop, with no voice bank, level metering or fades. */
+	const AudioBuffer<SampleType>& renderBaseline (MidiBuffer midi)
+	{
+		analyzeNextInput();
+
+		harmonizer.renderVoices (midi, baselineOutput);
+
+		return baselineOutput;
+	}
+
+	static constexpr auto samplerate	 = 48000.;
+	static constexpr auto inputFrequency = 196.;
+
+	int blocksize { 0 };
+
+	State							 state;
+	ParameterSnapshot				 snapshot;
+	AudioArena<SampleType>			 arena;
+	dsp::psola::Analyzer<SampleType> analyzer;
+
+	TestHarmonizer<SampleType> harmonizer { state, analyzer, snapshot, arena };
+
+private:
+
+	/* A vowel-like tone: a sawtooth with the upper harmonics rolled off. */
+	void analyzeNextInput()
+	{
+		const auto increment = juce::MathConstants<double>::twoPi * inputFrequency / samplerate;
+
+		auto sumOfSquares = 0.;
+
+		for (auto& sample : input)
+		{
+			auto value = 0.;
+
+			for (auto harmonic = 1; harmonic <= 12; ++harmonic)
+				value += std::sin (phase * harmonic) / (harmonic * harmonic);
+
+			phase  = std::fmod (phase + increment, juce::MathConstants<double>::twoPi);
+			sample = static_cast<SampleType> (0.3 * value);
+
+			sumOfSquares += static_cast<double> (sample * sample);
+		}
+
+		inputLevel = static_cast<SampleType> (std::sqrt (sumOfSquares / blocksize));
+
+		analyzer.analyzeInput (input.data(), blocksize);
+	}
+
+	std::vector<SampleType> input;
+	SampleType				inputLevel { 0 };
+	double					phase { 0. };
+
+	AudioBuffer<SampleType> baselineOutput;
+};
+
+}  // namespace Imogen::Tests
@@ -0,0 +1,41 @@
+/*
+	Measures the audio thread's time per block with pipelined rendering off and on, at several sample rates.
+	In pipelined mode the post-harmony effects run on the pipeline thread, so the difference is how much of the critical path they were.
+*/
+
+#include "ProcessorHarness.h"
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	static constexpr auto blocksize = 512;
+	static constexpr auto numBlocks = 300;
+
+	std::printf ("  samplerate   serial us/block   pipelined us/block   critical path\n");
+
+	for (const auto samplerate : { 44100., 48000., 96000., 192000. })
+	{
+		double times[2] {};
+
+		for (const auto pipelined : { false, true })
+		{
+			ProcessorHarness harness { samplerate, blocksize };
+
+			harness.getState().internals.pipelinedRendering->set (pipelined);
+			harness.prepare();
+
+			harness.holdChord (8);
+
+			for (auto i = 0; i < 50; ++i)
+				harness.processBlock();
+
+			times[pipelined ? 1 : 0] = microsecondsPerCall (numBlocks, [&]
+															{ harness.processBlock(); });
+		}
+
+		std::printf ("  %10.0f   %15.1f   %18.1f   %12.0f%%\n", samplerate, times[0], times[1], 100. * times[1] / times[0]);
+	}
+
+	return 0;
+}
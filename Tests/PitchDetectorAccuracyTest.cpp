@@ -0,0 +1,330 @@
+/*
+	Checks the FFT pitch detector against a labelled synthetic corpus, running it the way the engine does:
+	behind the decimator, fed in host-sized blocks, at several host sample rates.
+	Each block's estimate is compared with the true pitch at the centre of the samples it was measured over.
+	The psola analyzer's readout is scored on the same signals, and the detector fails wherever it does worse.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include <cstdio>
+#include <functional>
+#include <random>
+
+namespace Imogen::Tests
+{
+struct CorpusItem
+{
+	const char* category;
+
+	// the true fundamental at a given time in seconds; 0 means unpitched
+	std::function<double (double)> pitchAt;
+
+	double harmonicTilt;  // each harmonic's amplitude is 1 / h^tilt
+	double noiseLevel;	  // RMS of the added white noise, relative to the tone
+	bool   pitched;
+};
+
+struct Score
+{
+	int	   numFrames { 0 };
+	int	   numGrossErrors { 0 };  // voiced frames that are unpitched or more than 50 cents off
+	int	   numFalseVoiced { 0 };  // unpitched frames given a pitch
+	double totalCents { 0. };
+	int	   numFine { 0 };
+
+	double grossPercent() const { return numFrames > 0 ? 100. * (numGrossErrors + numFalseVoiced) / numFrames : 0.; }
+	double meanCents() const { return numFine > 0 ? totalCents / numFine : 0.; }
+};
+
+/* Renders 1.5 seconds of the item: up to 32 harmonics with random starting phases, plus white noise. */
+static std::vector<float> renderItem (const CorpusItem& item, double samplerate, std::mt19937& rng)
+{
+	static constexpr auto seconds = 1.5;
+
+	std::normal_distribution<double>	   noise { 0., 1. };
+	std::uniform_real_distribution<double> randomPhase { 0., juce::MathConstants<double>::twoPi };
+
+	std::vector<double> phases (32);
+
+	for (auto& phase : phases)
+		phase = randomPhase (rng);
+
+	// the tone's RMS, for scaling the noise
+	auto toneRms = 0.;
+
+	for (auto h = 1; h <= 32; ++h)
+		toneRms += 0.5 / std::pow (static_cast<double> (h), 2. * item.harmonicTilt);
+
+	toneRms = std::sqrt (toneRms);
+
+	std::vector<float> signal (static_cast<size_t> (seconds * samplerate));
+
+	for (auto i = 0; i < static_cast<int> (signal.size()); ++i)
+	{
+		const auto f0 = item.pitchAt (i / samplerate);
+
+		auto value = 0.;
+
+		if (f0 > 0.)
+		{
+			for (auto h = 1; h <= 32 && h * f0 < samplerate * 0.45; ++h)
+			{
+				auto& phase = phases[static_cast<size_t> (h - 1)];
+				value += std::sin (phase) / std::pow (static_cast<double> (h), item.harmonicTilt);
+				phase += juce::MathConstants<double>::twoPi * h * f0 / samplerate;
+			}
+		}
+
+		value += item.noiseLevel * toneRms * noise (rng);
+
+		signal[static_cast<size_t> (i)] = static_cast<float> (0.2 * value);
+	}
+
+	return signal;
+}
+
+/*
+	Scores one estimate against the true pitch at the middle of the samples it was measured over.
+	Both detectors are scored as the readout shows them, rounded to a note and whole cents.
+*/
+static void scoreEstimate (const CorpusItem& item, double measuredAt, double estimate, Score& score)
+{
+	++score.numFrames;
+
+	if (! item.pitched)
+	{
+		if (estimate > 0.)
+			++score.numFalseVoiced;
+
+		return;
+	}
+
+	if (estimate <= 0.)
+	{
+		++score.numGrossErrors;
+		return;
+	}
+
+	const auto midiPitch = 69. + 12. * std::log2 (estimate / 440.);
+	const auto shown	 = std::round (midiPitch * 100.) / 100.;
+	const auto cents	 = std::abs (100. * (shown - 69. - 12. * std::log2 (item.pitchAt (measuredAt) / 440.)));
+
+	if (cents > 50.)
+	{
+		++score.numGrossErrors;
+		return;
+	}
+
+	score.totalCents += cents;
+	++score.numFine;
+}
+
+/* The FFT detector, run the way the engine runs it: behind the decimator, fed in host-sized blocks. */
+static void scoreDetector (const CorpusItem& item, const std::vector<float>& signal, double samplerate, Score& score)
+{
+	static constexpr auto blocksize = 256;
+
+	Decimator<float>	 decimator;
+	PitchDetector<float> detector;
+
+	decimator.prepare (samplerate, blocksize);
+	detector.prepare (decimator.getOutputSamplerate(), blocksize / decimator.getFactor() + 1);
+
+	const auto frameSeconds = detector.getLatencySamples() / decimator.getOutputSamplerate();
+
+	// the decimator's linear-phase FIR has factor * 8 + 1 taps
+	const auto filterDelaySeconds = decimator.getFactor() > 1 ? decimator.getFactor() * 4 / samplerate : 0.;
+
+	const auto numBlocks = static_cast<int> (signal.size()) / blocksize;
+
+	for (auto b = 0; b < numBlocks; ++b)
+	{
+		const auto numDecimated = decimator.process (signal.data() + b * blocksize, blocksize);
+		detector.process (decimator.getOutput(), numDecimated);
+
+		const auto blockEnd = (b + 1) * blocksize / samplerate;
+
+		// skip the frames that still include the detector's initial silence
+		if (blockEnd < frameSeconds * 2.)
+			continue;
+
+		const auto estimate = static_cast<double> (detector.getFrequency());
+
+		// the frame is two longest periods, but YIN only reads its first longest period plus one period of the estimate
+		const auto frameStart	= blockEnd - filterDelaySeconds - frameSeconds;
+		const auto spanSeconds	= frameSeconds * 0.5 + (estimate > 0. ? 1. / estimate : frameSeconds * 0.5);
+
+		scoreEstimate (item, frameStart + spanSeconds * 0.5, estimate, score);
+	}
+}
+
+/*
+	The readout the engine shows when the FFT detector is off: the psola analyzer, read through the pitch corrector
+	as the lead processor does, fed in chunks as long as the analyzer's latency.
+*/
+struct AnalyzerReadout
+{
+	explicit AnalyzerReadout (double samplerateToUse)
+		: samplerate (samplerateToUse)
+	{
+		analyzer.setMinInputFreq (60);
+		analyzer.prepare (samplerate, 512);
+
+		chunkSize = analyzer.getLatencySamples();
+
+		arena.prepare (Harmonizer<float>::numArenaChannels + PitchCorrection<float>::numArenaChannels, chunkSize, false);
+
+		harmonizer.initialize (state.internals.voiceCapacity->get(), samplerate, chunkSize);
+	}
+
+	void score (const CorpusItem& item, const std::vector<float>& signal, Score& score)
+	{
+		// a fresh analysis for each item, as the detector gets
+		analyzer.prepare (samplerate, chunkSize);
+		harmonizer.prepare (samplerate, chunkSize);
+		corrector.prepare (samplerate, chunkSize);
+
+		const auto frameSeconds = chunkSize / samplerate;
+		const auto numChunks	= static_cast<int> (signal.size()) / chunkSize;
+
+		for (auto c = 0; c < numChunks; ++c)
+		{
+			analyzer.analyzeInput (signal.data() + c * chunkSize, chunkSize);
+			corrector.renderNextFrame (chunkSize);
+
+			const auto chunkEnd = (c + 1) * frameSeconds;
+
+			if (chunkEnd < frameSeconds * 2.)
+				continue;
+
+			const auto note = state.internals.currentInputNote->get();
+
+			const auto estimate = note < 0 ? 0.
+										   : 440. * std::pow (2., (note + state.internals.currentCentsSharp->get() * 0.01 - 69.) / 12.);
+
+			scoreEstimate (item, chunkEnd - frameSeconds * 0.5, estimate, score);
+		}
+	}
+
+	const double samplerate;
+	int			 chunkSize { 0 };
+
+	State						state;
+	ParameterSnapshot			snapshot;
+	AudioArena<float>			arena;
+	dsp::psola::Analyzer<float> analyzer;
+
+	Harmonizer<float>	   harmonizer { state, analyzer, snapshot, arena };
+	PitchCorrection<float> corrector { harmonizer, state.internals, arena };
+};
+
+static std::vector<CorpusItem> makeCorpus()
+{
+	std::vector<CorpusItem> corpus;
+
+	// 24 fundamentals spread evenly in pitch from 70 Hz to 1 kHz
+	for (auto i = 0; i < 24; ++i)
+	{
+		const auto f0 = 70. * std::pow (1000. / 70., i / 23.);
+
+		corpus.push_back ({ "steady, bright", [f0] (double)
+							{ return f0; },
+							1., 0., true });
+
+		corpus.push_back ({ "steady, dark", [f0] (double)
+							{ return f0; },
+							2., 0., true });
+
+		corpus.push_back ({ "vibrato 5.5 Hz +-50 cents", [f0] (double t)
+							{ return f0 * std::pow (2., 0.5 / 12. * std::sin (juce::MathConstants<double>::twoPi * 5.5 * t)); },
+							1., 0., true });
+
+		// the glide spans half an octave either side, so it's kept inside the detector's range,
+		// and turns around rather than jumping back, so no frame straddles an octave leap
+		if (f0 > 100. && f0 < 700.)
+			corpus.push_back ({ "glide, one octave per second", [f0] (double t)
+								{ return f0 * std::pow (2., std::abs (std::fmod (t, 2.) - 1.) - 0.5); },
+								1., 0., true });
+
+		corpus.push_back ({ "steady, 20 dB SNR", [f0] (double)
+							{ return f0; },
+							1., 0.1, true });
+	}
+
+	for (auto i = 0; i < 8; ++i)
+		corpus.push_back ({ "noise only", [] (double)
+							{ return 0.; },
+							1., 1., false });
+
+	return corpus;
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	struct Limit
+	{
+		const char* category;
+		double		maxGrossPercent, maxMeanCents;
+	};
+
+	const Limit limits[] = { { "steady, bright", 1., 3. },
+							 { "steady, dark", 1., 3. },
+							 { "vibrato 5.5 Hz +-50 cents", 3., 10. },
+							 { "glide, one octave per second", 5., 15. },
+							 { "steady, 20 dB SNR", 3., 5. },
+							 { "noise only", 5., 0. } };
+
+	const auto corpus = makeCorpus();
+
+	auto passed = true;
+
+	for (const auto samplerate : { 44100., 48000., 96000. })
+	{
+		AnalyzerReadout analyzer { samplerate };
+
+		std::printf ("\n%.0f Hz                                  FFT detector                 psola analyzer\n", samplerate);
+		std::printf ("  %-30s  frames   gross %%   mean cents   frames   gross %%   mean cents\n", "category");
+
+		for (const auto& limit : limits)
+		{
+			std::mt19937 rng { 7 };
+			Score		 detectorScore, analyzerScore;
+
+			for (const auto& item : corpus)
+			{
+				if (std::string (item.category) != limit.category)
+					continue;
+
+				const auto signal = renderItem (item, samplerate, rng);
+
+				scoreDetector (item, signal, samplerate, detectorScore);
+				analyzer.score (item, signal, analyzerScore);
+			}
+
+			const auto withinLimits = detectorScore.grossPercent() <= limit.maxGrossPercent
+								   && (limit.maxMeanCents == 0. || detectorScore.meanCents() <= limit.maxMeanCents);
+
+			// the new detector has to be at least as good as the readout it replaces, on the same signals;
+			// the readout shows whole cents, so a mean less than half a cent higher can't be seen
+			const auto noWorse = detectorScore.grossPercent() <= analyzerScore.grossPercent()
+							  && (limit.maxMeanCents == 0. || detectorScore.meanCents() < analyzerScore.meanCents() + 0.5);
+
+			std::printf ("  %-30s  %6d   %7.2f   %10.2f   %6d   %7.2f   %10.2f%s%s\n", limit.category,
+						 detectorScore.numFrames, detectorScore.grossPercent(), detectorScore.meanCents(),
+						 analyzerScore.numFrames, analyzerScore.grossPercent(), analyzerScore.meanCents(),
+						 withinLimits ? "" : "   FAILED", noWorse ? "" : "   WORSE THAN THE ANALYZER");
+
+			passed = passed && withinLimits && noWorse;
+		}
+	}
+
+	return passed ? 0 : 1;
+}
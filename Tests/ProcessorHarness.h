@@ -0,0 +1,110 @@
+#pragma once
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+namespace Imogen::Tests
+{
+/*
+	Drives a whole Imogen processor the way a host would: a synthetic sung vowel on the input,
+	and a held MIDI chord for the harmonizer.
+*/
+class ProcessorHarness
+{
+public:
+
+	ProcessorHarness (double samplerateToUse, int blocksizeToUse)
+		: samplerate (samplerateToUse), blocksize (blocksizeToUse)
+	{
+		prepare();
+	}
+
+	State& getState() { return processor.getState(); }
+
+	/* Re-prepares the processor, as a host does after a latency or settings change. */
+	void prepare()
+	{
+		processor.prepareToPlay (samplerate, blocksize);
+
+		const auto numChannels = std::max (processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+		buffer.setSize (numChannels, blocksize);
+	}
+
+	/* The note-ons are sent with the next block. */
+	void holdChord (int numNotes, int lowestNote = 43, int interval = 2)
+	{
+		releaseChord();
+
+		for (auto i = 0; i < numNotes; ++i)
+		{
+			const auto note = lowestNote + i * interval;
+
+			midi.addEvent (juce::MidiMessage::noteOn (1, note, 0.8f), 0);
+			heldNotes.add (note);
+		}
+	}
+
+	void releaseChord()
+	{
+		for (const auto note : heldNotes)
+			midi.addEvent (juce::MidiMessage::noteOff (1, note), 0);
+
+		heldNotes.clearQuick();
+	}
+
+	void processBlock()
+	{
+		fillInput();
+
+		processor.processBlock (buffer, midi);
+
+		midi.clear();
+	}
+
+	/* Lets the processor's message-thread work (pool creation, capacity changes, latency renegotiation) run. */
+	static void dispatchMessages (int milliseconds = 50)
+	{
+		juce::MessageManager::getInstance()->runDispatchLoopUntil (milliseconds);
+	}
+
+	/* A vowel-like tone: a sawtooth with the upper harmonics rolled off. */
+	static constexpr auto inputFrequency = 196.;
+
+	// declared first so that the message manager outlives the processor
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	const double samplerate;
+	const int	 blocksize;
+
+	Processor processor;
+
+	juce::AudioBuffer<float> buffer;
+
+private:
+
+	void fillInput()
+	{
+		const auto increment = juce::MathConstants<double>::twoPi * inputFrequency / samplerate;
+
+		for (auto s = 0; s < blocksize; ++s)
+		{
+			auto sample = 0.;
+
+			for (auto harmonic = 1; harmonic <= 12; ++harmonic)
+				sample += std::sin (phase * harmonic) / (harmonic * harmonic);
+
+			phase = std::fmod (phase + increment, juce::MathConstants<double>::twoPi);
+
+			for (auto chan = 0; chan < buffer.getNumChannels(); ++chan)
+				buffer.setSample (chan, s, static_cast<float> (0.3 * sample));
+		}
+	}
+
+	juce::MidiBuffer midi;
+	juce::Array<int> heldNotes;
+
+	double phase { 0. };
+};
+
+}  // namespace Imogen::Tests
@@ -0,0 +1,142 @@
+/*
+	Drives the processor through the things most likely to touch the heap or a lock on the audio thread:
+	re-prepares, note-on/off storms, bypass and effect toggles, parameter sweeps and the message-thread reconfigurations.
+	Built with IMOGEN_RT_SENTINEL on, so every violation inside the engine's render is reported with a stack trace, and fails the test.
+*/
+
+#include "ProcessorHarness.h"
+
+#include <random>
+
+namespace Imogen::Tests
+{
+static void noteStorm (ProcessorHarness& harness, std::mt19937& random, int numBlocks)
+{
+	std::uniform_int_distribution<int> numNotes { 1, 24 }, lowestNote { 30, 70 }, interval { 1, 5 };
+
+	for (auto block = 0; block < numBlocks; ++block)
+	{
+		if (block % 3 == 2)
+			harness.releaseChord();
+		else
+			harness.holdChord (numNotes (random), lowestNote (random), interval (random));
+
+		harness.processBlock();
+	}
+}
+
+static void bypassToggles (ProcessorHarness& harness, int numBlocks)
+{
+	auto& parameters = harness.getState().parameters;
+
+	for (auto block = 0; block < numBlocks; ++block)
+	{
+		const auto on = block % 2 == 0;
+
+		parameters.leadBypass->set (block % 4 == 1);
+		parameters.harmonyBypass->set (block % 6 == 3);
+		parameters.noiseGateToggle->set (on);
+		parameters.deEsserToggle->set (! on);
+		parameters.compToggle->set (on);
+		parameters.delayToggle->set (block % 5 < 2);
+		parameters.limiterToggle->set (! on);
+		parameters.eqState.eqToggle->set (on);
+		parameters.reverbState.reverbToggle->set (block % 7 < 3);
+
+		harness.processBlock();
+	}
+}
+
+static void parameterSweeps (ProcessorHarness& harness, int numBlocks)
+{
+	auto& parameters = harness.getState().parameters;
+
+	for (auto block = 0; block < numBlocks; ++block)
+	{
+		const auto position = static_cast<float> (block) / static_cast<float> (numBlocks - 1);
+		const auto percent	= juce::roundToInt (position * 100.f);
+
+		parameters.dryWet->set (percent);
+		parameters.inputGain->set (-24.f + 36.f * position);
+		parameters.outputGain->set (-24.f + 30.f * position);
+		parameters.stereoWidth->set (percent);
+		parameters.noiseGateThresh->set (-60.f * position);
+		parameters.compAmount->set (percent);
+		parameters.delayDryWet->set (percent);
+		parameters.eqState.eqPeakGain->set (4.f * position);
+		parameters.reverbState.reverbDryWet->set (percent);
+		parameters.reverbState.reverbDecay->set (percent);
+		parameters.reverbState.reverbEngine->set (1 + block % 3);
+		parameters.midiState.pitchbendRange->set (block % 13);
+		parameters.midiState.adsrAttack->set (position);
+
+		harness.processBlock();
+	}
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen;
+	using namespace Imogen::Tests;
+
+	static_assert (IMOGEN_RT_SENTINEL, "this test needs the sentinel compiled in");
+
+	std::mt19937 random { 2022 };
+
+	ProcessorHarness harness { 48000., 256 };
+
+	auto& internals = harness.getState().internals;
+
+	// the engine only meters while something reads the meters, the way an open editor does
+	const MeterSnapshot::Reader meterReader { harness.getState().meters.snapshot };
+
+	for (const auto blocksize : { 256, 32, 1024 })
+	{
+		ProcessorHarness stormHarness { 44100., blocksize };
+
+		noteStorm (stormHarness, random, 300);
+	}
+
+	for (const auto parallel : { false, true })
+	{
+		internals.parallelVoiceRendering->set (parallel);
+
+		for (const auto pipelined : { false, true })
+		{
+			internals.pipelinedRendering->set (pipelined);
+			ProcessorHarness::dispatchMessages();
+
+			harness.prepare();
+
+			noteStorm (harness, random, 200);
+			bypassToggles (harness, 200);
+			parameterSweeps (harness, 200);
+		}
+	}
+
+	// reconfigurations made on the message thread while notes are held
+	harness.holdChord (12);
+
+	for (const auto capacity : { 32, 4, 64, 16 })
+	{
+		internals.voiceCapacity->set (capacity);
+		ProcessorHarness::dispatchMessages (20);
+
+		noteStorm (harness, random, 50);
+	}
+
+	internals.fftPitchDetection->set (true);
+	internals.latencyMode->set (1);
+	ProcessorHarness::dispatchMessages();
+
+	noteStorm (harness, random, 100);
+
+	const auto numViolations = RealtimeScope::getNumViolations();
+
+	std::printf ("real-time violations: %d\n", numViolations);
+
+	return numViolations > 0 ? 1 : 0;
+}
@@ -0,0 +1,223 @@
+/*
+	Compares the delay network reverb with the classic dsp::FX::Reverb at equal decay time and at least equal echo density.
+	For each engine it measures the impulse response's decay time (from the Schroeder integral) and its mixing time
+	(when the normalised echo density of Abel and Huang first reaches 0.9, meaning the tail has become noise-like).
+	The classic engine is set up the way Reverb sets it up for each decay setting; the network's decay setting is then searched
+	for the one whose decay time is closest, and only then is the cost of a stereo block at 100% wet compared.
+	The comparison is flagged if the network's tail still takes longer to become dense than the classic one's.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+namespace Imogen::Tests
+{
+struct ImpulseStats
+{
+	double t60Seconds { 0. }, mixingTimeMs { 0. };
+};
+
+/* Measures the left channel of a 100% wet impulse response. */
+template <typename ProcessFunction>
+static ImpulseStats measureImpulse (ProcessFunction&& process, double samplerate, int blocksize)
+{
+	const auto length = static_cast<int> (samplerate * 6.);
+
+	std::vector<float> response;
+	response.reserve (static_cast<size_t> (length));
+
+	juce::AudioBuffer<float> block { 2, blocksize };
+
+	for (auto done = 0; done < length; done += blocksize)
+	{
+		block.clear();
+
+		if (done == 0)
+		{
+			block.setSample (0, 0, 1.f);
+			block.setSample (1, 0, 1.f);
+		}
+
+		process (block);
+
+		response.insert (response.end(), block.getReadPointer (0), block.getReadPointer (0) + blocksize);
+	}
+
+	ImpulseStats stats;
+
+	// T60 from the -5 to -35 dB span of the backwards-integrated energy
+	std::vector<double> energy (response.size() + 1, 0.);
+
+	for (auto i = response.size(); i > 0; --i)
+		energy[i - 1] = energy[i] + static_cast<double> (response[i - 1]) * response[i - 1];
+
+	if (energy[0] > 0.)
+	{
+		auto start = -1, end = -1;
+
+		for (auto i = 0; i < static_cast<int> (response.size()); ++i)
+		{
+			const auto db = 10. * std::log10 (std::max (energy[static_cast<size_t> (i)] / energy[0], 1.0e-30));
+
+			if (start < 0 && db <= -5.)
+				start = i;
+
+			if (db <= -35.)
+			{
+				end = i;
+				break;
+			}
+		}
+
+		if (start >= 0 && end > start)
+			stats.t60Seconds = 2. * (end - start) / samplerate;
+	}
+
+	// normalised echo density over 20 ms windows; erfc (1 / sqrt 2) is the fraction of a Gaussian beyond one standard deviation
+	const auto window = static_cast<int> (samplerate * 0.02);
+	const auto gaussianFraction = std::erfc (1. / std::sqrt (2.));
+
+	stats.mixingTimeMs = -1.;
+
+	for (auto start = 0; start + window < static_cast<int> (response.size()); start += window / 4)
+	{
+		auto sumOfSquares = 0.;
+
+		for (auto i = start; i < start + window; ++i)
+			sumOfSquares += static_cast<double> (response[static_cast<size_t> (i)]) * response[static_cast<size_t> (i)];
+
+		const auto sigma = std::sqrt (sumOfSquares / window);
+
+		if (sigma <= 0.)
+			continue;
+
+		auto outside = 0;
+
+		for (auto i = start; i < start + window; ++i)
+			if (std::abs (response[static_cast<size_t> (i)]) > sigma)
+				++outside;
+
+		if (outside / static_cast<double> (window) / gaussianFraction >= 0.9)
+		{
+			stats.mixingTimeMs = 1000. * (start + window / 2) / samplerate;
+			break;
+		}
+	}
+
+	return stats;
+}
+
+template <typename ProcessFunction>
+static double timeBlocks (ProcessFunction&& process, int blocksize)
+{
+	juce::AudioBuffer<float> block { 2, blocksize };
+
+	auto phase = 0u;
+
+	return microsecondsPerCall (2000, [&]
+								{
+									for (auto chan = 0; chan < 2; ++chan)
+										for (auto i = 0; i < blocksize; ++i)
+											block.setSample (chan, i, static_cast<float> (((phase++ * 2654435761u) >> 16) & 0xff) / 512.f - 0.25f);
+
+									process (block);
+									doNotOptimise (block);
+								});
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen;
+	using namespace Imogen::Tests;
+
+	static constexpr auto samplerate = 48000.;
+	static constexpr auto blocksize	 = 256;
+
+	float level;
+
+	const auto makeNetwork = [] (int decay)
+	{
+		auto fdn = std::make_unique<FdnReverb<float>>();
+		fdn->prepare (samplerate, blocksize);
+		fdn->setDryWet (100);
+		fdn->setDuckAmount (0);
+		fdn->setLoCutFrequency (20.f);
+		fdn->setHiCutFrequency (20000.f);
+		fdn->setDecay (decay);
+		return fdn;
+	};
+
+	const auto measureNetwork = [&] (int decay)
+	{
+		auto fdn = makeNetwork (decay);
+
+		return measureImpulse ([&] (juce::AudioBuffer<float>& block)
+							   { fdn->process (block, &level); },
+							   samplerate, blocksize);
+	};
+
+	std::printf ("  classic decay %%   T60 s   mixing ms   us/block   |   network decay %%   T60 s   mixing ms   us/block   cost\n");
+
+	auto allMatched = true;
+
+	for (const auto decay : { 30, 60, 90 })
+	{
+		// the same mapping from the decay parameter that Reverb uses for the classic engine
+		dsp::FX::Reverb classic;
+		classic.prepare (blocksize, samplerate, 2);
+		classic.setDryWet (100);
+		classic.setDuckAmount (0);
+		classic.setLoCutFrequency (20.f);
+		classic.setHiCutFrequency (20000.f);
+		classic.setRoomSize (static_cast<float> (decay) * 0.01f);
+		classic.setDamping (1.f - static_cast<float> (decay) * 0.01f);
+
+		const auto processClassic = [&] (juce::AudioBuffer<float>& block)
+		{ classic.process (block, &level); };
+
+		const auto classicStats = measureImpulse (processClassic, samplerate, blocksize);
+
+		// the network's decay time rises monotonically with its setting, so the closest match is found by bisection
+		auto low = 0, high = 100;
+
+		while (high - low > 1)
+		{
+			const auto middle = (low + high) / 2;
+
+			if (measureNetwork (middle).t60Seconds < classicStats.t60Seconds)
+				low = middle;
+			else
+				high = middle;
+		}
+
+		const auto lowStats	   = measureNetwork (low);
+		const auto highStats   = measureNetwork (high);
+		const auto useHigh	   = std::abs (highStats.t60Seconds - classicStats.t60Seconds) < std::abs (lowStats.t60Seconds - classicStats.t60Seconds);
+		const auto fdnDecay	   = useHigh ? high : low;
+		const auto fdnStats	   = useHigh ? highStats : lowStats;
+		const auto fdnIsDenser = fdnStats.mixingTimeMs >= 0. && (classicStats.mixingTimeMs < 0. || fdnStats.mixingTimeMs <= classicStats.mixingTimeMs);
+
+		auto fdn = makeNetwork (fdnDecay);
+
+		const auto classicTime = timeBlocks (processClassic, blocksize);
+		const auto fdnTime	   = timeBlocks ([&] (juce::AudioBuffer<float>& block)
+											 { fdn->process (block, &level); },
+											 blocksize);
+
+		std::printf ("  %15d   %5.2f   %9.1f   %8.2f   |   %15d   %5.2f   %9.1f   %8.2f   %3.0f%%%s\n",
+					 decay, classicStats.t60Seconds, classicStats.mixingTimeMs, classicTime,
+					 fdnDecay, fdnStats.t60Seconds, fdnStats.mixingTimeMs, fdnTime, 100. * fdnTime / classicTime,
+					 fdnIsDenser ? "" : "   NOT AS DENSE");
+
+		allMatched = allMatched && fdnIsDenser;
+	}
+
+	if (! allMatched)
+		std::printf ("\nwhere the network's tail becomes dense later than the classic one's, its cost isn't at equal density\n");
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+	Times the real psola analyzer and shifters the way the harmonizer drives them: one analysis per block,
+	then one shifter per voice resynthesising from it, for chords of increasing size.
+	Each shifter extracts and windows its own grains inside lemons_psola, where they can't be counted or timed separately,
+	so the shifters' time per voice is an upper bound on what a grain cache shared by all voices could save, not a measurement of it.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+int main()
+{
+	using namespace Imogen;
+	using namespace Imogen::Tests;
+
+	static constexpr auto samplerate	 = 48000.;
+	static constexpr auto inputFrequency = 196.;
+	static constexpr auto numCalls		 = 1000;
+
+	dsp::psola::Analyzer<float> analyzer;
+	analyzer.setMinInputFreq (60);
+	analyzer.prepare (samplerate, 512);
+
+	// the engine runs in chunks as long as the analyzer's latency
+	const auto blocksize = analyzer.getLatencySamples();
+	analyzer.prepare (samplerate, blocksize);
+
+	// one second of a vowel-like tone, a sawtooth with the upper harmonics rolled off.
+	// The input frequency is a whole number of hertz, so it loops seamlessly, and it's made up front so little more than the analysis is timed
+	std::vector<float> tone (static_cast<size_t> (samplerate));
+
+	for (size_t i = 0; i < tone.size(); ++i)
+	{
+		const auto phase = juce::MathConstants<double>::twoPi * inputFrequency * static_cast<double> (i) / samplerate;
+
+		auto value = 0.;
+
+		for (auto harmonic = 1; harmonic <= 12; ++harmonic)
+			value += std::sin (phase * harmonic) / (harmonic * harmonic);
+
+		tone[i] = static_cast<float> (0.3 * value);
+	}
+
+	std::vector<float> input (static_cast<size_t> (blocksize));
+	size_t			   readPosition = 0;
+
+	const auto analyzeNextBlock = [&]
+	{
+		for (auto& sample : input)
+		{
+			sample		 = tone[readPosition];
+			readPosition = (readPosition + 1) % tone.size();
+		}
+
+		analyzer.analyzeInput (input.data(), blocksize);
+	};
+
+	// let the analyzer lock on before anything is timed
+	for (auto i = 0; i < 50; ++i)
+		analyzeNextBlock();
+
+	const auto analysisTime = microsecondsPerCall (numCalls, analyzeNextBlock);
+
+	std::printf ("%d-sample chunks at %.0f Hz, input at %.0f Hz: analysis %.1f us/chunk\n\n",
+				 blocksize, samplerate, inputFrequency, analysisTime);
+
+	std::printf ("  voices   shifters us/chunk   us/voice   shifters / analysis\n");
+
+	for (const auto numVoices : { 1, 4, 8, 12, 16 })
+	{
+		std::vector<std::unique_ptr<dsp::psola::Shifter<float>>> shifters;
+		std::vector<juce::AudioBuffer<float>>					 outputs;
+
+		for (auto i = 0; i < numVoices; ++i)
+		{
+			// a chord spread in thirds above and below the input
+			const auto semitones = (i % 2 == 0 ? 1 : -1) * 4 * ((i + 1) / 2);
+
+			shifters.push_back (std::make_unique<dsp::psola::Shifter<float>> (analyzer));
+			shifters.back()->setPitch (static_cast<float> (inputFrequency * std::pow (2., semitones / 12.)), samplerate);
+
+			outputs.emplace_back (1, blocksize);
+		}
+
+		const auto renderVoices = [&]
+		{
+			for (size_t i = 0; i < shifters.size(); ++i)
+				shifters[i]->getSamples (outputs[i]);
+		};
+
+		for (auto i = 0; i < 20; ++i)
+		{
+			analyzeNextBlock();
+			renderVoices();
+		}
+
+		// the shifters need a fresh analysis every chunk, so they're timed together with it and the analysis is taken off
+		const auto chunkTime = microsecondsPerCall (numCalls, [&]
+													{
+														analyzeNextBlock();
+														renderVoices();
+													});
+
+		const auto shifterTime = std::max (chunkTime - analysisTime, 0.);
+
+		for (const auto& output : outputs)
+			doNotOptimise (output);
+
+		std::printf ("  %6d   %17.1f   %8.1f   %19.1f\n",
+					 numVoices, shifterTime, shifterTime / numVoices, shifterTime / analysisTime);
+	}
+
+	return 0;
+}
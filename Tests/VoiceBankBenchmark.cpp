@@ -0,0 +1,80 @@
+/*
+	Compares the harmonizer's voice bank path, which renders each voice into its scratch channels and then sums it,
+	applies its fade and measures its level in one pass, against the synth's own render loop that the harmonizer used before,
+	where each voice adds itself straight into the output and nothing is measured.
+	Both render the same held chords through real voices, so the outputs are also checked against each other.
+*/
+
+#include "HarmonizerRig.h"
+#include "BenchmarkUtils.h"
+
+namespace Imogen::Tests
+{
+template <typename SampleType>
+static bool runScenario (const char* typeName, int numVoices)
+{
+	static constexpr auto numCalls = 2000;
+
+	HarmonizerRig<SampleType> baseline { false }, bank { false };
+
+	MidiBuffer chord;
+
+	for (auto i = 0; i < numVoices; ++i)
+		chord.addEvent (juce::MidiMessage::noteOn (1, 40 + i * 2, 0.8f), 0);
+
+	baseline.renderBaseline (chord);
+	bank.process (chord);
+
+	// the voices' attacks have finished by the time the comparison starts
+	for (auto i = 0; i < 100; ++i)
+	{
+		baseline.renderBaseline ({});
+		bank.process ({});
+	}
+
+	auto maxDifference = 0.;
+
+	for (auto i = 0; i < 50; ++i)
+	{
+		const auto& expected = baseline.renderBaseline ({});
+		const auto& actual	 = bank.process ({});
+
+		for (auto chan = 0; chan < 2; ++chan)
+			for (auto s = 0; s < bank.blocksize; ++s)
+				maxDifference = std::max (maxDifference, std::abs (static_cast<double> (actual.getSample (chan, s) - expected.getSample (chan, s))));
+	}
+
+	const auto baselineTime = microsecondsPerCall (numCalls, [&]
+												   { doNotOptimise (baseline.renderBaseline ({})); });
+
+	const auto bankTime = microsecondsPerCall (numCalls, [&]
+											   { doNotOptimise (bank.process ({})); });
+
+	const auto matches = maxDifference <= 1.0e-5;
+
+	std::printf ("  %-6s  %2d voices  %4d samples   renderVoices %8.1f us   voice bank %8.1f us   %5.2fx   max difference %.2g%s\n",
+				 typeName, numVoices, bank.blocksize, baselineTime, bankTime, baselineTime / bankTime, maxDifference,
+				 matches ? "" : "   MISMATCH");
+
+	return matches;
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+	auto passed = true;
+
+	for (const auto numVoices : { 4, 8, 16 })
+	{
+		passed = runScenario<float> ("float", numVoices) && passed;
+		passed = runScenario<double> ("double", numVoices) && passed;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+/*
+	Measures what each voice costs, in memory and in render time, at several voice capacities,
+	and checks that changing the capacity while audio is running never stalls the audio thread.
+*/
+
+#include "ProcessorHarness.h"
+
+#include <thread>
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	static constexpr auto samplerate = 48000.;
+	static constexpr auto blocksize	 = 256;
+	static constexpr auto numBlocks	 = 200;
+
+	ProcessorHarness harness { samplerate, blocksize };
+
+	auto& internals = harness.getState().internals;
+
+	// the arena figure is only what the engine lays out itself, so the process's resident size is shown alongside it
+	std::printf ("  capacity   resident KB   arena KB   us/block (full chord)   us/voice\n");
+
+	for (const auto capacity : { 4, 8, 16, 32, 64 })
+	{
+		internals.voiceCapacity->set (capacity);
+		ProcessorHarness::dispatchMessages();
+
+		// the new voices are swapped in by the next block, and the old ones are freed on the message thread after it
+		harness.processBlock();
+		ProcessorHarness::dispatchMessages (50);
+
+		// the arena internal is only updated when the engine is prepared
+		harness.prepare();
+
+		harness.holdChord (capacity, 32, capacity > 32 ? 1 : 2);
+
+		for (auto i = 0; i < 50; ++i)
+			harness.processBlock();
+
+		const auto time = microsecondsPerCall (numBlocks, [&]
+											   { harness.processBlock(); });
+
+		std::printf ("  %8d   %11ld   %8d   %21.1f   %8.2f\n",
+					 capacity, residentMemoryKb(), internals.arenaFootprintKb->get(), time, time / capacity);
+
+		harness.releaseChord();
+	}
+
+	// change the capacity back and forth on the message thread while another thread renders,
+	// and record the slowest block the audio thread saw
+	std::atomic<bool> stop { false };
+	double			  slowestBlock = 0., typicalBlock = 0.;
+
+	harness.holdChord (8);
+
+	std::thread audioThread { [&]
+							  {
+								  typicalBlock = microsecondsPerCall (numBlocks, [&]
+																	  { harness.processBlock(); });
+
+								  while (! stop.load())
+								  {
+									  const auto start = std::chrono::steady_clock::now();
+									  harness.processBlock();
+									  const auto elapsed = std::chrono::duration<double, std::micro> (std::chrono::steady_clock::now() - start).count();
+
+									  slowestBlock = std::max (slowestBlock, elapsed);
+								  }
+							  } };
+
+	for (auto i = 0; i < 40; ++i)
+	{
+		internals.voiceCapacity->set (i % 2 == 0 ? 64 : 8);
+		ProcessorHarness::dispatchMessages (20);
+	}
+
+	stop.store (true);
+	audioThread.join();
+
+	std::printf ("\nwhile the capacity changed 40 times: typical block %.1f us, slowest block %.1f us\n", typicalBlock, slowestBlock);
+
+	return 0;
+}
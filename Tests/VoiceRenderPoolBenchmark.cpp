@@ -0,0 +1,128 @@
+/*
+	Measures how the block render time scales with the number of VoiceRenderPool workers,
+	for a block rendered in one range and for a block split into several ranges by MIDI events.
+	Fails if the parallel sum differs from the serial one by even one bit.
+*/
+
+#include <imogen_dsp/imogen_dsp.h>
+
+#include "BenchmarkUtils.h"
+
+namespace Imogen::Tests
+{
+/* Stands in for the harmonizer: each job renders one "voice" of roughly the cost of a shifted voice. */
+struct SyntheticVoices : VoiceRenderPool::Client
+{
+	SyntheticVoices (int numVoicesToUse, int numSamplesToUse)
+		: numVoices (numVoicesToUse), numSamples (numSamplesToUse),
+		  scratch (static_cast<size_t> (numVoices * numSamples)), sum (static_cast<size_t> (numSamples))
+	{
+	}
+
+	void renderJob (int jobIndex) final
+	{
+		auto* out = scratch.data() + jobIndex * rangeLength;
+
+		const auto increment = 0.01f * static_cast<float> (jobIndex + 1);
+
+		for (auto s = 0; s < rangeLength; ++s)
+		{
+			auto value = 0.f;
+
+			for (auto h = 1; h <= workPerSample; ++h)
+				value += std::sin (phase[static_cast<size_t> (jobIndex)] * static_cast<float> (h)) / static_cast<float> (h);
+
+			phase[static_cast<size_t> (jobIndex)] += increment;
+			out[s] = value;
+		}
+	}
+
+	void renderBlock (VoiceRenderPool* pool, int numRanges)
+	{
+		std::fill (sum.begin(), sum.end(), 0.f);
+
+		for (auto r = 0; r < numRanges; ++r)
+		{
+			const auto start = numSamples * r / numRanges;
+			rangeLength		 = numSamples * (r + 1) / numRanges - start;
+
+			if (pool != nullptr)
+				pool->run (numVoices);
+			else
+				for (auto job = 0; job < numVoices; ++job)
+					renderJob (job);
+
+			for (auto v = 0; v < numVoices; ++v)
+				for (auto s = 0; s < rangeLength; ++s)
+					sum[static_cast<size_t> (start + s)] += scratch[static_cast<size_t> (v * rangeLength + s)];
+		}
+
+		if (pool != nullptr)
+			pool->endBlock();
+	}
+
+	void reset() { std::fill (phase.begin(), phase.end(), 0.f); }
+
+	static constexpr auto workPerSample = 12;
+
+	const int numVoices, numSamples;
+	int		  rangeLength { 0 };
+
+	std::vector<float> scratch, sum;
+	std::vector<float> phase = std::vector<float> (static_cast<size_t> (numVoices), 0.f);
+};
+
+static bool runScenario (int numVoices, int numSamples, int numRanges)
+{
+	static constexpr auto numBlocks = 400;
+
+	SyntheticVoices voices { numVoices, numSamples };
+
+	voices.renderBlock (nullptr, numRanges);
+	const auto reference = voices.sum;
+
+	const auto serialTime = microsecondsPerCall (numBlocks, [&]
+												 { voices.renderBlock (nullptr, numRanges); });
+
+	std::printf ("\n%d voices, %d samples, %d range(s) per block\n", numVoices, numSamples, numRanges);
+	std::printf ("  workers   us/block   speedup\n");
+	std::printf ("  serial    %8.1f     1.00\n", serialTime);
+
+	auto identical = true;
+
+	const auto maxWorkers = std::max (static_cast<int> (std::thread::hardware_concurrency()) - 1, 1);
+
+	for (auto numWorkers = 1; numWorkers <= maxWorkers; ++numWorkers)
+	{
+		VoiceRenderPool pool { voices, numWorkers };
+
+		voices.reset();
+		voices.renderBlock (&pool, numRanges);
+
+		identical = identical && voices.sum == reference;
+
+		const auto time = microsecondsPerCall (numBlocks, [&]
+											   { voices.renderBlock (&pool, numRanges); });
+
+		std::printf ("  %7d   %8.1f     %4.2f\n", numWorkers, time, serialTime / time);
+	}
+
+	if (! identical)
+		std::printf ("  FAILED: the parallel sum differs from the serial sum\n");
+
+	return identical;
+}
+
+}  // namespace Imogen::Tests
+
+
+int main()
+{
+	using namespace Imogen::Tests;
+
+	auto passed = runScenario (16, 512, 1);
+	passed		= runScenario (16, 512, 4) && passed;
+	passed		= runScenario (16, 64, 1) && passed;
+
+	return passed ? 0 : 1;
+}